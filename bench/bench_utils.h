@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include "core/types.h"
+#include "platform/platform.h"
+
+// Shared bits for the benchmarks in bench/. Every .cpp in here is its own
+// program built by build.sh, run them from a release build.
+
+// Results get added into this so the compiler can't throw the work away
+static volatile u64 bench_sink;
+
+inline void bench_keep(u64 value)
+{
+    bench_sink = bench_sink + value;
+}
+
+// splitmix64, good enough for making up keys and the same every run
+inline u64 bench_random(u64& state)
+{
+    u64 z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Fastest of a few runs, in seconds. Setup that shouldn't be timed goes in setup().
+template <typename Setup, typename Func>
+inline f64 bench_best_time(u32 runs, Setup setup, Func func)
+{
+    f64 best = 1e30;
+    for (u32 i = 0; i < runs; i++)
+    {
+        setup();
+
+        const f64 start = platform_get_time();
+        func();
+        const f64 time = platform_get_time() - start;
+
+        best = (time < best) ? time : best;
+    }
+
+    return best;
+}
+
+template <typename Func>
+inline f64 bench_best_time(u32 runs, Func func)
+{
+    return bench_best_time(runs, [] {}, func);
+}
+
+// First command line argument if there is one, for capping the biggest size on smaller machines
+inline u64 bench_max_count(int argc, char** argv, u64 default_max)
+{
+    return (argc > 1) ? strtoull(argv[1], nullptr, 10) : default_max;
+}
+
+inline const char* bench_count_name(u64 count)
+{
+    static char names[4][32];
+    static u32 next = 0;
+
+    char* name = names[next++ % 4];
+    if (count >= 1000000 && count % 1000000 == 0)
+        snprintf(name, 32, "%lluM", (unsigned long long) (count / 1000000));
+    else if (count >= 1000 && count % 1000 == 0)
+        snprintf(name, 32, "%lluK", (unsigned long long) (count / 1000));
+    else
+        snprintf(name, 32, "%llu", (unsigned long long) count);
+
+    return name;
+}
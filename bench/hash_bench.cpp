@@ -0,0 +1,273 @@
+// Throughput, collisions and avalanche for every Hasher specialization.
+// Usage: hash_bench [max string length]
+
+#include <algorithm>
+#include <cmath>
+#include "bench_utils.h"
+#include "core/compiler_utils.h"
+#include "containers/hash.h"
+#include "core/atom.h"
+
+// Keys hashed per collision set, spread over a table twice that size
+#define COLLISION_KEY_BITS 19
+#define COLLISION_KEY_COUNT (1u << COLLISION_KEY_BITS)
+#define COLLISION_BUCKET_BITS 20
+
+#define AVALANCHE_SAMPLES 4096
+#define THROUGHPUT_BYTES (64ull << 20)
+
+// Long keys get fewer collision keys and avalanche samples so they don't take forever
+#define MAX_BYTES_HASHED (1ull << 30)
+
+// Avalanche is measured over the first 64 bytes, longer keys go through the same code
+#define AVALANCHE_MAX_BYTES 64
+
+// Xorshifts and odd multiplies kept to the low bits, a bijection so random keys
+// never repeat even when the key is only a few bytes
+static u64 bench_mix(u64 x, u32 bits)
+{
+    const u64 mask  = (bits >= 64) ? ~0ull : (1ull << bits) - 1;
+    const u32 shift = bits / 2;
+
+    x ^= x >> shift;
+    x = (x * 0xBF58476D1CE4E5B9ull) & mask;
+    x ^= x >> shift;
+    x = (x * 0x94D049BB133111EBull) & mask;
+    return x ^ (x >> shift);
+}
+
+enum struct KeySet
+{
+    SEQUENTIAL,
+    STRIDED,
+    RANDOM,
+};
+
+// Writes key number index of the set into bytes. Sequential and strided keys only
+// change the first 8 bytes, the rest stay zero like a padded id would.
+static void make_key_bytes(u8* bytes, u64 size, KeySet set, u64 index)
+{
+    platform_set_memory(bytes, 0, size);
+
+    // Strides of 4096 unless the key is too small to fit them without wrapping around
+    const u32 bits = (u32) std::min(size * 8, (u64) 64);
+    const u32 stride_shift = std::min(12u, bits - COLLISION_KEY_BITS);
+
+    u64 value = 0;
+    switch (set)
+    {
+        case KeySet::SEQUENTIAL: value = index; break;
+        case KeySet::STRIDED:    value = index << stride_shift; break;
+        case KeySet::RANDOM:     value = bench_mix(index, bits); break;
+    }
+
+    platform_copy_memory(bytes, &value, std::min(size, (u64) sizeof(value)));
+
+    if (set == KeySet::RANDOM)
+    {
+        u64 state = value;
+        for (u64 offset = sizeof(value); offset < size; offset += sizeof(u64))
+        {
+            const u64 random = bench_random(state);
+            platform_copy_memory(bytes + offset, &random, std::min(size - offset, (u64) sizeof(u64)));
+        }
+    }
+}
+
+// n keys thrown into m buckets at random leave m * (1 - 1/m)^n buckets empty,
+// every key that didn't get a bucket of its own is a collision
+static f64 expected_bucket_collisions(f64 n, f64 m)
+{
+    return n - m * (1.0 - pow(1.0 - 1.0 / m, n));
+}
+
+// Every key is built from size bytes with make_key(const u8* bytes), so the same
+// measurements work for integers, pointers, floats and strings
+template <typename Key, typename MakeKey>
+static void bench_hasher(const char* name, u64 size, MakeKey make_key)
+{
+    Hasher<Key> hasher;
+
+    // Throughput over about THROUGHPUT_BYTES of random keys
+    {
+        const u64 count = std::max(THROUGHPUT_BYTES / std::max(size, (u64) 8), (u64) 16);
+
+        u8* bytes = (u8*) platform_allocate(count * size);
+        u64 state = 1;
+        for (u64 offset = 0; offset < count * size; offset += sizeof(u64))
+        {
+            const u64 random = bench_random(state);
+            platform_copy_memory(bytes + offset, &random, std::min(count * size - offset, (u64) sizeof(u64)));
+        }
+
+        Key* keys = (Key*) platform_allocate(count * sizeof(Key));
+        for (u64 i = 0; i < count; i++)
+            keys[i] = make_key(bytes + i * size);
+
+        const f64 time = bench_best_time(5, [&]
+        {
+            Hash sum = 0;
+            for (u64 i = 0; i < count; i++)
+                sum += hasher(keys[i]);
+
+            bench_keep(sum);
+        });
+
+        printf("%-22s %10.2f GB/s %8.2f ns/key\n", name, (f64) (count * size) / time / 1e9, 1e9 * time / count);
+
+        platform_free(keys);
+        platform_free(bytes);
+    }
+
+    // Collisions, both of the whole hash and of the buckets in a hash table,
+    // HashTable picks its group from the bits above the 7 it keeps in the control byte
+    {
+        const u64 key_count = std::min((u64) COLLISION_KEY_COUNT, MAX_BYTES_HASHED / size);
+
+        Hash* hashes = (Hash*) platform_allocate(key_count * sizeof(Hash));
+        u8* bytes = (u8*) platform_allocate(size);
+
+        const u64 bucket_count = 1ull << COLLISION_BUCKET_BITS;
+        u8* buckets = (u8*) platform_allocate(bucket_count);
+
+        const char* set_names[] = { "sequential", "strided", "random" };
+        const KeySet sets[] = { KeySet::SEQUENTIAL, KeySet::STRIDED, KeySet::RANDOM };
+
+        for (u32 s = 0; s < 3; s++)
+        {
+            platform_set_memory(buckets, 0, bucket_count);
+
+            u64 bucket_collisions = 0;
+            for (u64 i = 0; i < key_count; i++)
+            {
+                make_key_bytes(bytes, size, sets[s], i);
+                hashes[i] = hasher(make_key(bytes));
+
+                u8& bucket = buckets[(hashes[i] >> 7) & (bucket_count - 1)];
+                bucket_collisions += bucket;
+                bucket = 1;
+            }
+
+            std::sort(hashes, hashes + key_count);
+
+            u64 duplicates = 0;
+            for (u64 i = 1; i < key_count; i++)
+                duplicates += hashes[i] == hashes[i - 1];
+
+            const f64 expected = expected_bucket_collisions((f64) key_count, (f64) bucket_count);
+            printf("    %-10s %6llu duplicate hashes %8llu bucket collisions (%.3fx random)\n", set_names[s],
+                   (unsigned long long) duplicates, (unsigned long long) bucket_collisions, bucket_collisions / expected);
+        }
+
+        platform_free(buckets);
+        platform_free(bytes);
+        platform_free(hashes);
+    }
+
+    // Avalanche, flipping any input bit should flip every output bit half the time
+    {
+        const u64 input_bits = std::min(size, (u64) AVALANCHE_MAX_BYTES) * 8;
+        const u64 samples = std::clamp(MAX_BYTES_HASHED / (input_bits * size), (u64) 64, (u64) AVALANCHE_SAMPLES);
+
+        u32* flips = (u32*) platform_allocate(input_bits * 64 * sizeof(u32));
+        platform_set_memory(flips, 0, input_bits * 64 * sizeof(u32));
+
+        u8* bytes = (u8*) platform_allocate(size);
+        u64 total_flipped = 0;
+
+        for (u64 sample = 0; sample < samples; sample++)
+        {
+            make_key_bytes(bytes, size, KeySet::RANDOM, sample);
+            const Hash hash = hasher(make_key(bytes));
+
+            for (u64 bit = 0; bit < input_bits; bit++)
+            {
+                bytes[bit / 8] ^= (u8) (1u << (bit % 8));
+                const Hash flipped = hash ^ hasher(make_key(bytes));
+                bytes[bit / 8] ^= (u8) (1u << (bit % 8));
+
+                total_flipped += GN_POPULATION_COUNT_64(flipped);
+                for (u32 out = 0; out < 64; out++)
+                    flips[bit * 64 + out] += (flipped >> out) & 1;
+            }
+        }
+
+        f64 worst_bias = 0.0;
+        for (u64 i = 0; i < input_bits * 64; i++)
+            worst_bias = std::max(worst_bias, fabs((f64) flips[i] / samples - 0.5));
+
+        printf("    avalanche  %.4f of output bits flip on average, worst bias %.4f (noise is about %.4f)\n",
+               (f64) total_flipped / (samples * input_bits * 64), worst_bias, 2.0 / sqrt((f64) samples));
+
+        platform_free(bytes);
+        platform_free(flips);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    platform_init_clock();
+
+    const u64 max_length = bench_max_count(argc, argv, 65536);
+
+    bench_hasher<s32>("s32", sizeof(s32), [](const u8* bytes)
+    {
+        s32 key;
+        platform_copy_memory(&key, bytes, sizeof(key));
+        return key;
+    });
+
+    // -0.0f and 0.0f are the same key so one duplicate is expected when both come up
+    bench_hasher<f32>("f32", sizeof(f32), [](const u8* bytes)
+    {
+        f32 key;
+        platform_copy_memory(&key, bytes, sizeof(key));
+        return key;
+    });
+
+    bench_hasher<u64>("u64", sizeof(u64), [](const u8* bytes)
+    {
+        u64 key;
+        platform_copy_memory(&key, bytes, sizeof(key));
+        return key;
+    });
+
+    bench_hasher<void*>("void*", sizeof(void*), [](const u8* bytes)
+    {
+        void* key;
+        platform_copy_memory(&key, bytes, sizeof(key));
+        return key;
+    });
+
+    // Only the id gets hashed, made up ids hash the same way as interned ones
+    bench_hasher<Atom>("Atom", sizeof(u32), [](const u8* bytes)
+    {
+        Atom key;
+        platform_copy_memory(&key.id, bytes, sizeof(key.id));
+        return key;
+    });
+
+    // Each length goes down a different path in hash_bytes
+    const u64 lengths[] = { 3, 8, 16, 32, 64, 256, 1024, 65536 };
+    for (u64 length : lengths)
+    {
+        if (length > max_length)
+            break;
+
+        char name[32];
+        snprintf(name, sizeof(name), "String (%s)", bench_count_name(length));
+
+        bench_hasher<String>(name, length, [length](const u8* bytes)
+        {
+            return String { (char*) bytes, length, nullptr };
+        });
+    }
+
+    // The hash is worked out when the key is made, so this is mostly the cost of the
+    // string hash up front and then a load per lookup
+    bench_hasher<HashedString>("HashedString (16)", 16, [](const u8* bytes)
+    {
+        return hashed(String { (char*) bytes, 16, nullptr });
+    });
+}
+
@@ -0,0 +1,278 @@
+// HashTable (control bytes probed 16 at a time with SSE2) against the table
+// it replaced, at 1K, 100K and 10M u64 -> u64 entries.
+// Usage: hash_table_bench [max entries]
+
+#include "bench_utils.h"
+#include "containers/hash_table.h"
+
+// The old table: separate state, hash, key and value arrays, a modulo capacity
+// and linear probing one slot at a time. Kept the same apart from the hash type.
+struct LinearProbeTable
+{
+    enum struct State : u8
+    {
+        EMPTY,
+        TOMBSTONE,
+        ALIVE
+    };
+
+    State* states;
+    Hash*  hashes;
+    u64*   keys;
+    u64*   values;
+
+    u32 filled;
+    u32 capacity;
+
+    Hasher<u64> hasher;
+};
+
+static LinearProbeTable linear_probe_make(u32 capacity)
+{
+    using State = LinearProbeTable::State;
+
+    LinearProbeTable table = {};
+    table.capacity = capacity;
+
+    u8* allocation = (u8*) platform_allocate(capacity * (sizeof(State) + sizeof(Hash) + 2 * sizeof(u64)));
+    table.states = (State*) allocation;
+    table.hashes = (Hash*)  (allocation + capacity * sizeof(State));
+    table.keys   = (u64*)   (allocation + capacity * (sizeof(State) + sizeof(Hash)));
+    table.values = table.keys + capacity;
+
+    platform_set_memory(table.states, (int) State::EMPTY, capacity * sizeof(State));
+    return table;
+}
+
+static void linear_probe_free(LinearProbeTable& table)
+{
+    platform_free(table.states);
+    table = {};
+}
+
+static u32 linear_probe_place(LinearProbeTable& table, const u64 key, const Hash hash, const u64 value);
+
+static void linear_probe_resize(LinearProbeTable& table, u32 new_capacity)
+{
+    using State = LinearProbeTable::State;
+
+    LinearProbeTable new_table = linear_probe_make(new_capacity);
+    for (u32 i = 0; i < table.capacity; i++)
+    {
+        if (table.states[i] == State::ALIVE)
+            linear_probe_place(new_table, table.keys[i], table.hashes[i], table.values[i]);
+    }
+
+    linear_probe_free(table);
+    table = new_table;
+}
+
+static u32 linear_probe_place(LinearProbeTable& table, const u64 key, const Hash hash, const u64 value)
+{
+    using State = LinearProbeTable::State;
+
+    const u32 end_index   = (u32) (hash % table.capacity);
+    const u32 start_index = (end_index + 1) % table.capacity;
+
+    for (u32 i = start_index; i != end_index; i = (i + 1) % table.capacity)
+    {
+        if (table.states[i] != State::ALIVE)
+        {
+            table.filled++;
+
+            table.states[i] = State::ALIVE;
+            table.hashes[i] = hash;
+            table.keys[i]   = key;
+            table.values[i] = value;
+            return i;
+        }
+
+        if (table.hashes[i] == hash && table.keys[i] == key)
+            return i;
+    }
+
+    return table.capacity;
+}
+
+static u32 linear_probe_put(LinearProbeTable& table, const u64 key, const u64 value)
+{
+    if ((f32) table.filled / (f32) table.capacity >= 0.75f)
+        linear_probe_resize(table, table.capacity * 2);
+
+    return linear_probe_place(table, key, table.hasher(key), value);
+}
+
+static u32 linear_probe_find(const LinearProbeTable& table, const u64 key)
+{
+    using State = LinearProbeTable::State;
+
+    const Hash hash = table.hasher(key);
+    const u32 end_index   = (u32) (hash % table.capacity);
+    const u32 start_index = (end_index + 1) % table.capacity;
+
+    for (u32 i = start_index; i != end_index; i = (i + 1) % table.capacity)
+    {
+        if (table.states[i] == State::EMPTY)
+            return table.capacity;
+
+        if (table.states[i] == State::ALIVE && table.hashes[i] == hash && table.keys[i] == key)
+            return i;
+    }
+
+    return table.capacity;
+}
+
+static void linear_probe_remove(LinearProbeTable& table, const u64 key)
+{
+    const u32 index = linear_probe_find(table, key);
+    if (index < table.capacity)
+        table.states[index] = LinearProbeTable::State::TOMBSTONE;
+}
+
+struct Timings
+{
+    f64 insert;
+    f64 find_hit;
+    f64 find_miss;
+    f64 remove;
+};
+
+static Timings bench_hash_table(const u64* keys, const u64* missing_keys, u64 count, u32 runs)
+{
+    Timings timings;
+    HashTable<u64, u64> table = {};
+
+    timings.insert = bench_best_time(runs, [&] { free(table); }, [&]
+    {
+        table = make<HashTable<u64, u64>>();
+        for (u64 i = 0; i < count; i++)
+            put(table, keys[i], i);
+    });
+
+    timings.find_hit = bench_best_time(runs, [&]
+    {
+        u64 sum = 0;
+        for (u64 i = 0; i < count; i++)
+            sum += find(table, keys[count - 1 - i]).value();
+
+        bench_keep(sum);
+    });
+
+    timings.find_miss = bench_best_time(runs, [&]
+    {
+        u64 found = 0;
+        for (u64 i = 0; i < count; i++)
+            found += (bool) find(table, missing_keys[i]);
+
+        bench_keep(found);
+    });
+
+    timings.remove = bench_best_time(runs, [&]
+    {
+        free(table);
+        table = make<HashTable<u64, u64>>();
+        for (u64 i = 0; i < count; i++)
+            put(table, keys[i], i);
+    }, [&]
+    {
+        for (u64 i = 0; i < count; i++)
+        {
+            auto element = find(table, keys[i]);
+            remove(element);
+        }
+    });
+
+    free(table);
+    return timings;
+}
+
+static Timings bench_linear_probe(const u64* keys, const u64* missing_keys, u64 count, u32 runs)
+{
+    Timings timings;
+    LinearProbeTable table = {};
+
+    timings.insert = bench_best_time(runs, [&] { linear_probe_free(table); }, [&]
+    {
+        table = linear_probe_make(32);
+        for (u64 i = 0; i < count; i++)
+            linear_probe_put(table, keys[i], i);
+    });
+
+    timings.find_hit = bench_best_time(runs, [&]
+    {
+        u64 sum = 0;
+        for (u64 i = 0; i < count; i++)
+            sum += table.values[linear_probe_find(table, keys[count - 1 - i])];
+
+        bench_keep(sum);
+    });
+
+    timings.find_miss = bench_best_time(runs, [&]
+    {
+        u64 found = 0;
+        for (u64 i = 0; i < count; i++)
+            found += linear_probe_find(table, missing_keys[i]) < table.capacity;
+
+        bench_keep(found);
+    });
+
+    timings.remove = bench_best_time(runs, [&]
+    {
+        linear_probe_free(table);
+        table = linear_probe_make(32);
+        for (u64 i = 0; i < count; i++)
+            linear_probe_put(table, keys[i], i);
+    }, [&]
+    {
+        for (u64 i = 0; i < count; i++)
+            linear_probe_remove(table, keys[i]);
+    });
+
+    linear_probe_free(table);
+    return timings;
+}
+
+int main(int argc, char** argv)
+{
+    platform_init_clock();
+
+    const u64 max_count = bench_max_count(argc, argv, 10000000);
+    const u64 counts[] = { 1000, 100000, 10000000 };
+
+    printf("%-8s %-10s %14s %14s %14s\n", "entries", "op", "new ns/op", "old ns/op", "speedup");
+
+    for (u64 count : counts)
+    {
+        if (count > max_count)
+            break;
+
+        // Random keys, the missing ones come from a different seed so they're practically never in the table
+        u64* keys = (u64*) platform_allocate(2 * count * sizeof(u64));
+        u64* missing_keys = keys + count;
+
+        u64 seed = 1;
+        for (u64 i = 0; i < count; i++)
+            keys[i] = bench_random(seed);
+
+        seed = 2;
+        for (u64 i = 0; i < count; i++)
+            missing_keys[i] = bench_random(seed);
+
+        const u32 runs = (count <= 100000) ? 20 : 3;
+
+        const Timings new_table = bench_hash_table(keys, missing_keys, count, runs);
+        const Timings old_table = bench_linear_probe(keys, missing_keys, count, runs);
+
+        const char* names[] = { "insert", "find hit", "find miss", "remove" };
+        const f64 new_times[] = { new_table.insert, new_table.find_hit, new_table.find_miss, new_table.remove };
+        const f64 old_times[] = { old_table.insert, old_table.find_hit, old_table.find_miss, old_table.remove };
+
+        for (u32 i = 0; i < 4; i++)
+        {
+            printf("%-8s %-10s %14.2f %14.2f %13.2fx\n", bench_count_name(count), names[i],
+                   1e9 * new_times[i] / count, 1e9 * old_times[i] / count, old_times[i] / new_times[i]);
+        }
+
+        platform_free(keys);
+    }
+}
@@ -0,0 +1,181 @@
+// Throughput of SpscQueue and MpmcQueue, one item at a time and in batches,
+// with 1 to 16 producers. Threads yield when the queue is full or empty, so on
+// a machine with fewer cores than threads this measures handoff, not scaling.
+// Usage: queue_bench [items per run]
+
+#include <atomic>
+#include "bench_utils.h"
+#include "containers/queue.h"
+
+#define QUEUE_BENCH_CAPACITY 4096
+#define QUEUE_BENCH_BATCH 64
+#define QUEUE_BENCH_MAX_THREADS 32
+
+template <typename Queue>
+struct QueueBench
+{
+    Queue* queue;
+    u64 items_per_producer;
+    u64 total_items;
+    u64 batch;
+
+    std::atomic<bool> go;
+    std::atomic<u64>  popped;
+    std::atomic<u64>  sum;
+};
+
+template <typename Queue>
+struct QueueBenchThread
+{
+    QueueBench<Queue>* bench;
+    u64 first_item;
+};
+
+template <typename Queue>
+static void queue_bench_producer(void* data)
+{
+    QueueBenchThread<Queue>& thread = *(QueueBenchThread<Queue>*) data;
+    QueueBench<Queue>& bench = *thread.bench;
+
+    while (!bench.go.load(std::memory_order_acquire))
+        platform_thread_yield();
+
+    u64 items[QUEUE_BENCH_BATCH];
+    const u64 end = thread.first_item + bench.items_per_producer;
+
+    for (u64 next = thread.first_item; next < end; )
+    {
+        u64 pushed = 0;
+        if (bench.batch == 1)
+        {
+            pushed = push(*bench.queue, next);
+        }
+        else
+        {
+            const u64 count = min(bench.batch, end - next);
+            for (u64 i = 0; i < count; i++)
+                items[i] = next + i;
+
+            pushed = push_n(*bench.queue, items, count);
+        }
+
+        if (pushed == 0)
+            platform_thread_yield();
+
+        next += pushed;
+    }
+}
+
+template <typename Queue>
+static void queue_bench_consumer(void* data)
+{
+    QueueBenchThread<Queue>& thread = *(QueueBenchThread<Queue>*) data;
+    QueueBench<Queue>& bench = *thread.bench;
+
+    while (!bench.go.load(std::memory_order_acquire))
+        platform_thread_yield();
+
+    u64 items[QUEUE_BENCH_BATCH];
+    u64 sum = 0;
+
+    while (bench.popped.load(std::memory_order_relaxed) < bench.total_items)
+    {
+        const u64 count = (bench.batch == 1) ? (u64) pop(*bench.queue, items[0]) : pop_n(*bench.queue, items, bench.batch);
+        if (count == 0)
+        {
+            platform_thread_yield();
+            continue;
+        }
+
+        for (u64 i = 0; i < count; i++)
+            sum += items[i];
+
+        bench.popped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    bench.sum.fetch_add(sum, std::memory_order_relaxed);
+}
+
+// Returns items per second, or 0 if items went missing
+template <typename Queue>
+static f64 queue_bench_run(Queue& queue, u32 producers, u32 consumers, u64 total_items, u64 batch)
+{
+    QueueBench<Queue> bench;
+    bench.queue = &queue;
+    bench.items_per_producer = total_items / producers;
+    bench.total_items = bench.items_per_producer * producers;
+    bench.batch = batch;
+    bench.go = false;
+    bench.popped = 0;
+    bench.sum = 0;
+
+    QueueBenchThread<Queue> thread_data[QUEUE_BENCH_MAX_THREADS];
+    PlatformThread threads[QUEUE_BENCH_MAX_THREADS];
+
+    for (u32 i = 0; i < producers; i++)
+    {
+        thread_data[i] = { &bench, 1 + i * bench.items_per_producer };
+        threads[i] = platform_thread_create(queue_bench_producer<Queue>, &thread_data[i], "bench producer");
+    }
+
+    for (u32 i = producers; i < producers + consumers; i++)
+    {
+        thread_data[i] = { &bench, 0 };
+        threads[i] = platform_thread_create(queue_bench_consumer<Queue>, &thread_data[i], "bench consumer");
+    }
+
+    const f64 start = platform_get_time();
+    bench.go.store(true, std::memory_order_release);
+
+    for (u32 i = 0; i < producers + consumers; i++)
+        platform_thread_join(threads[i]);
+
+    const f64 time = platform_get_time() - start;
+
+    // Items are 1..total_items, each popped exactly once
+    if (bench.sum != bench.total_items * (bench.total_items + 1) / 2)
+        return 0.0;
+
+    return bench.total_items / time;
+}
+
+static void print_result(const char* name, u32 producers, u32 consumers, u64 batch, f64 items_per_second)
+{
+    if (items_per_second == 0.0)
+        printf("%-6s %9u %9u %6llu   FAILED, items went missing\n", name, producers, consumers, (unsigned long long) batch);
+    else
+        printf("%-6s %9u %9u %6llu %12.2f M items/s\n", name, producers, consumers, (unsigned long long) batch, items_per_second / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    platform_init_clock();
+
+    const u64 total_items = bench_max_count(argc, argv, 10000000);
+    const u64 batches[] = { 1, QUEUE_BENCH_BATCH };
+
+    printf("%-6s %9s %9s %6s %20s\n", "queue", "producers", "consumers", "batch", "throughput");
+
+    for (u64 batch : batches)
+    {
+        SpscQueue<u64> queue = make<SpscQueue<u64>>((u64) QUEUE_BENCH_CAPACITY);
+        print_result("spsc", 1, 1, batch, queue_bench_run(queue, 1, 1, total_items, batch));
+        free(queue);
+    }
+
+    const u32 producer_counts[] = { 1, 2, 4, 8, 16 };
+    for (u64 batch : batches)
+    {
+        for (u32 producers : producer_counts)
+        {
+            // One consumer draining everything, then as many consumers as producers
+            const u32 consumer_counts[] = { 1, producers };
+            for (u32 c = 0; c < ((producers == 1) ? 1 : 2); c++)
+            {
+                MpmcQueue<u64> queue = make<MpmcQueue<u64>>((u64) QUEUE_BENCH_CAPACITY);
+                print_result("mpmc", producers, consumer_counts[c], batch, queue_bench_run(queue, producers, consumer_counts[c], total_items, batch));
+                free(queue);
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// sort and radix_sort against std::sort on u64 keys, from 1K up to 100M elements.
+// 100M needs about 2.4GB, pass a smaller maximum on smaller machines.
+// Usage: sort_bench [max elements]
+
+#include <algorithm>
+#include "bench_utils.h"
+#include "containers/sort.h"
+
+enum struct Pattern
+{
+    RANDOM,
+    SORTED,
+    REVERSED,
+    FEW_UNIQUE,
+};
+
+static void fill_pattern(u64* data, u64 count, Pattern pattern)
+{
+    u64 state = count;
+    for (u64 i = 0; i < count; i++)
+    {
+        switch (pattern)
+        {
+            case Pattern::RANDOM:     data[i] = bench_random(state); break;
+            case Pattern::SORTED:     data[i] = i; break;
+            case Pattern::REVERSED:   data[i] = count - i; break;
+            case Pattern::FEW_UNIQUE: data[i] = bench_random(state) % 16; break;
+        }
+    }
+}
+
+static bool is_sorted(const u64* data, u64 count)
+{
+    for (u64 i = 1; i < count; i++)
+    {
+        if (data[i] < data[i - 1])
+            return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    platform_init_clock();
+
+    const u64 max_count = bench_max_count(argc, argv, 100000000);
+    const u64 counts[] = { 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+    const char* pattern_names[] = { "random", "sorted", "reversed", "few unique" };
+    const Pattern patterns[] = { Pattern::RANDOM, Pattern::SORTED, Pattern::REVERSED, Pattern::FEW_UNIQUE };
+
+    printf("%-6s %-10s %16s %16s %16s %9s %9s\n", "count", "pattern", "std::sort ns/el", "sort ns/el", "radix ns/el", "sort", "radix");
+
+    for (u64 count : counts)
+    {
+        if (count > max_count)
+            break;
+
+        u64* source = (u64*) platform_allocate(count * sizeof(u64));
+        u64* data   = (u64*) platform_allocate(count * sizeof(u64));
+
+        // About the same amount of work for every size, the big ones only run once
+        const u32 runs = (u32) clamp(10000000ull / count, 1ull, 100ull);
+
+        for (u32 p = 0; p < 4; p++)
+        {
+            fill_pattern(source, count, patterns[p]);
+
+            auto reset = [&] { platform_copy_memory(data, source, count * sizeof(u64)); };
+            bool sorted = true;
+
+            const f64 std_time = bench_best_time(runs, reset, [&] { std::sort(data, data + count); });
+            sorted &= is_sorted(data, count);
+
+            const f64 sort_time = bench_best_time(runs, reset, [&] { sort(data, count); });
+            sorted &= is_sorted(data, count);
+
+            const f64 radix_time = bench_best_time(runs, reset, [&] { radix_sort(data, count, [](u64 key) { return key; }); });
+            sorted &= is_sorted(data, count);
+
+            // Last two columns are the speedup over std::sort
+            printf("%-6s %-10s %16.2f %16.2f %16.2f %8.2fx %8.2fx%s\n", bench_count_name(count), pattern_names[p],
+                   1e9 * std_time / count, 1e9 * sort_time / count, 1e9 * radix_time / count,
+                   std_time / sort_time, std_time / radix_time, sorted ? "" : "   NOT SORTED");
+        }
+
+        platform_free(data);
+        platform_free(source);
+    }
+}
@@ -12,6 +12,11 @@ if "%1"=="release" (
     set link_flags= /DEBUG /NODEFAULTLIB:LIBCMT /LTCG
 )
 
+rem Heap tracking per memory tag, "build.bat debug track_memory"
+if "%2"=="track_memory" (
+    set defines=%defines% /DGN_TRACK_MEMORY
+)
+
 set includes= /I src ^
               /I dependencies\glad\include   ^
               /I dependencies\wglext\include ^
@@ -24,6 +29,8 @@ set libs= shell32.lib                     ^
           openGL32.lib                    ^
           msvcrt.lib                      ^
           comdlg32.lib                    ^
+          synchronization.lib             ^
+          winmm.lib                       ^
           dependencies\glad\lib\glad.lib  ^
           dependencies\stb\lib\stb.lib    ^
           dependencies\miniz\lib\miniz.lib
@@ -0,0 +1,60 @@
+#!/bin/bash
+
+# Headless Linux build. There's no window or OpenGL on Linux so only the CPU side of the
+# engine (containers, serialization, fileio, core, math) gets built, as a static library.
+# Every .cpp in tests/ and bench/ is its own program linked against it.
+# Everything ends up in build/linux, use "./build.sh release" for benchmark numbers.
+
+set -e
+
+root="$(cd "$(dirname "$0")" && pwd)"
+build_dir="$root/build/linux"
+obj_dir="$build_dir/obj"
+
+library_name="libthe_waiting_game_headless.a"
+
+compiler=${CXX:-g++}
+if [[ "$compiler" == *clang* ]]; then
+    compiler_define="-DGN_COMPILER_CLANG"
+else
+    compiler_define="-DGN_COMPILER_GCC"
+fi
+
+if [ "$1" == "release" ]; then
+    defines="-DGN_PLATFORM_LINUX -DGN_RELEASE -DNDEBUG $compiler_define"
+    compile_flags="-O2 -std=c++17 -pthread"
+else
+    defines="-DGN_PLATFORM_LINUX -DGN_DEBUG $compiler_define"
+    compile_flags="-g -std=c++17 -pthread"
+fi
+
+# Heap tracking per memory tag, "./build.sh debug track_memory"
+if [ "$2" == "track_memory" ]; then
+    defines="$defines -DGN_TRACK_MEMORY"
+fi
+
+includes="-I $root/src -I $root/dependencies/miniz/include -I $root/dependencies/stb/include"
+
+rm -rf "$obj_dir"
+mkdir -p "$obj_dir"
+cd "$obj_dir"
+
+# Source
+$compiler $compile_flags -c "$root"/src/serialization/json/*.cpp $defines $includes
+$compiler $compile_flags -c "$root"/src/serialization/binary/*.cpp $defines $includes
+$compiler $compile_flags -c "$root"/src/fileio/*.cpp $defines $includes
+$compiler $compile_flags -c "$root"/src/platform/platform_linux.cpp $defines $includes
+$compiler $compile_flags -c "$root"/src/core/{atom,frame_pacer,linear_arena,logger_basic,memory_tracker,utils}.cpp $defines $includes
+$compiler $compile_flags -c "$root"/src/math/*.cpp $defines $includes
+
+# Dependencies, the prebuilt ones are Windows only
+${CC:-gcc} -O2 -c "$root"/dependencies/miniz/src/*.c -I "$root"/dependencies/miniz/include
+
+rm -f "$build_dir/$library_name"
+ar rcs "$build_dir/$library_name" *.o
+
+# Programs
+for program in "$root"/tests/*.cpp "$root"/bench/*.cpp; do
+    [ -e "$program" ] || continue
+    $compiler $compile_flags "$program" -o "$build_dir/$(basename "$program" .cpp)" $defines $includes "$build_dir/$library_name"
+done
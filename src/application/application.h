@@ -4,6 +4,7 @@
 #include "containers/function.h"
 #include "math/vecs/vector4.h"
 #include "core/types.h"
+#include "core/frame_pacer.h"
 
 enum struct WindowStyle
 {
@@ -43,6 +44,14 @@ struct Application
     f32 time = 0.0f;
     f32 delta_time = 0.0f;
 
+    bool vsync = true;
+    f32 target_frame_rate = 0.0f;       // Frames are held to this on top of vsync, 0 means no limit
+    FramePacerStats frame_times = {};   // Over the last few hundred frames
+
+#ifdef GN_DEBUG
+    u64 frame_allocation_count = 0;     // Heap allocations made during the last frame
+#endif // GN_DEBUG
+
     Vector4 clear_color;
 
     bool is_running;
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <emmintrin.h>
+#include "core/types.h"
+#include "core/common.h"
+#include "core/allocator.h"
+#include "platform/platform.h"
+#include "hash.h"
+#include "hash_table.h"
+
+// Hash table that can be used from multiple threads. Keys are split across
+// ShardCount regular HashTables by the top bits of their hash (the tables
+// themselves use the low bits) and every shard has its own reader/writer
+// lock, so threads only contend when they hit the same shard and readers
+// never block each other.
+// Elements can't be handed out by reference since another thread could move
+// them, so lookups copy the value out while the shard is locked.
+
+#define CONCURRENT_HASH_TABLE_TEMPLATE template <typename KeyType, typename ValueType, typename Hasher = Hasher<KeyType>, u32 ShardCount = 16>
+#define CONCURRENT_HASH_TABLE_TYPE ConcurrentHashTable<KeyType, ValueType, Hasher, ShardCount>
+#define CONCURRENT_HASH_TABLE_CACHE_LINE_SIZE 64
+#define CONCURRENT_HASH_TABLE_WRITER_BIT 0x80000000u
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+struct ConcurrentHashTable
+{
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "Shard count has to be a power of 2!");
+
+    // Each shard sits on its own cache line(s) so locking one doesn't slow down the others
+    struct alignas(CONCURRENT_HASH_TABLE_CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<u32> lock;      // Writer bit and number of readers
+        HashTable<KeyType, ValueType, Hasher> table;
+    };
+
+    Shard* shards;
+
+    Hasher hasher;
+    Allocator* allocator;
+};
+
+static constexpr u32 concurrent_hash_table_log2(u32 value)
+{
+    u32 result = 0;
+    while (value >>= 1)
+        result++;
+
+    return result;
+}
+
+static inline void concurrent_hash_table_read_lock(std::atomic<u32>& lock)
+{
+    while (true)
+    {
+        // Readers wait for writers, even ones that are only waiting for the lock
+        u32 state = lock.load(std::memory_order_relaxed);
+        if (!(state & CONCURRENT_HASH_TABLE_WRITER_BIT) && lock.compare_exchange_weak(state, state + 1, std::memory_order_acquire))
+            return;
+
+        _mm_pause();
+    }
+}
+
+static inline void concurrent_hash_table_read_unlock(std::atomic<u32>& lock)
+{
+    lock.fetch_sub(1, std::memory_order_release);
+}
+
+static inline void concurrent_hash_table_write_lock(std::atomic<u32>& lock)
+{
+    // Claim the writer bit first so no new readers get in, then wait for the current ones to leave
+    while (lock.fetch_or(CONCURRENT_HASH_TABLE_WRITER_BIT, std::memory_order_acquire) & CONCURRENT_HASH_TABLE_WRITER_BIT)
+        _mm_pause();
+
+    while (lock.load(std::memory_order_acquire) != CONCURRENT_HASH_TABLE_WRITER_BIT)
+        _mm_pause();
+}
+
+static inline void concurrent_hash_table_write_unlock(std::atomic<u32>& lock)
+{
+    lock.store(0, std::memory_order_release);
+}
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+static inline typename CONCURRENT_HASH_TABLE_TYPE::Shard& concurrent_hash_table_shard(CONCURRENT_HASH_TABLE_TYPE& table, const Hash hash)
+{
+    // Top bits so the shard doesn't correlate with the slot inside the shard
+    constexpr u32 shard_bits = concurrent_hash_table_log2(ShardCount);
+    return table.shards[(shard_bits > 0) ? (u32) (hash >> (64 - shard_bits)) : 0];
+}
+
+// Start capacity is per shard
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline CONCURRENT_HASH_TABLE_TYPE make(Type<CONCURRENT_HASH_TABLE_TYPE>, u32 start_cap = 32, Allocator* allocator = nullptr)
+{
+    using HashTable = HashTable<KeyType, ValueType, Hasher>;
+    using Shard     = typename CONCURRENT_HASH_TABLE_TYPE::Shard;
+
+    CONCURRENT_HASH_TABLE_TYPE table;
+    table.allocator = allocator;
+
+    table.shards = (Shard*) allocator_allocate(table.allocator, ShardCount * sizeof(Shard), alignof(Shard));
+    gn_assert_with_message(table.shards, "Could not allocate data for concurrent hash table!");
+
+    for (u32 i = 0; i < ShardCount; i++)
+    {
+        new (&table.shards[i].lock) std::atomic<u32>(0);
+        table.shards[i].table = make<HashTable>(start_cap, allocator);
+    }
+
+    return table;
+}
+
+// None of the free functions lock, no other thread can be using the table anymore
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline void free(CONCURRENT_HASH_TABLE_TYPE& table)
+{
+    using Shard = typename CONCURRENT_HASH_TABLE_TYPE::Shard;
+
+    for (u32 i = 0; i < ShardCount; i++)
+        free(table.shards[i].table);
+
+    allocator_free(table.allocator, table.shards, ShardCount * sizeof(Shard), alignof(Shard));
+
+    table.shards = nullptr;
+}
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline void free_keys(CONCURRENT_HASH_TABLE_TYPE& table)
+{
+    for (u32 i = 0; i < ShardCount; i++)
+        free_keys(table.shards[i].table);
+}
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline void free_values(CONCURRENT_HASH_TABLE_TYPE& table)
+{
+    for (u32 i = 0; i < ShardCount; i++)
+        free_values(table.shards[i].table);
+}
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline void free_all(CONCURRENT_HASH_TABLE_TYPE& table)
+{
+    free_keys(table);
+    free_values(table);
+    free(table);
+}
+
+// Copies the value into out_value and returns true if the key exists
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline bool find(CONCURRENT_HASH_TABLE_TYPE& table, const KeyType& key, ValueType& out_value)
+{
+    const Hash hash = table.hasher(key);
+    auto& shard = concurrent_hash_table_shard(table, hash);
+
+    concurrent_hash_table_read_lock(shard.lock);
+
+    // Elements can't be looked at once the shard is unlocked
+    auto elem = find_with_hash(shard.table, key, hash);
+    const bool found = (bool) elem;
+    if (found)
+        out_value = elem.value();
+
+    concurrent_hash_table_read_unlock(shard.lock);
+
+    return found;
+}
+
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline bool contains(CONCURRENT_HASH_TABLE_TYPE& table, const KeyType& key)
+{
+    const Hash hash = table.hasher(key);
+    auto& shard = concurrent_hash_table_shard(table, hash);
+
+    concurrent_hash_table_read_lock(shard.lock);
+    const bool found = (bool) find_with_hash(shard.table, key, hash);
+    concurrent_hash_table_read_unlock(shard.lock);
+
+    return found;
+}
+
+// Same as HashTable's put, an existing value isn't overwritten. Returns the value
+// that ends up in the table so racing threads all agree on which one won.
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline ValueType put(CONCURRENT_HASH_TABLE_TYPE& table, const KeyType& key, const ValueType& value)
+{
+    const Hash hash = table.hasher(key);
+    auto& shard = concurrent_hash_table_shard(table, hash);
+
+    concurrent_hash_table_write_lock(shard.lock);
+    const ValueType result = put_with_hash(shard.table, key, hash, value).value();
+    concurrent_hash_table_write_unlock(shard.lock);
+
+    return result;
+}
+
+// Returns false if the key wasn't in the table
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline bool remove(CONCURRENT_HASH_TABLE_TYPE& table, const KeyType& key)
+{
+    const Hash hash = table.hasher(key);
+    auto& shard = concurrent_hash_table_shard(table, hash);
+
+    concurrent_hash_table_write_lock(shard.lock);
+
+    auto elem = find_with_hash(shard.table, key, hash);
+    const bool found = (bool) elem;
+    if (found)
+        remove(elem);
+
+    concurrent_hash_table_write_unlock(shard.lock);
+
+    return found;
+}
+
+// Only a snapshot, other threads can change it right after
+CONCURRENT_HASH_TABLE_TEMPLATE
+inline u64 count(CONCURRENT_HASH_TABLE_TYPE& table)
+{
+    u64 result = 0;
+    for (u32 i = 0; i < ShardCount; i++)
+    {
+        concurrent_hash_table_read_lock(table.shards[i].lock);
+        result += table.shards[i].table.count;
+        concurrent_hash_table_read_unlock(table.shards[i].lock);
+    }
+
+    return result;
+}
+
+#undef CONCURRENT_HASH_TABLE_WRITER_BIT
+#undef CONCURRENT_HASH_TABLE_CACHE_LINE_SIZE
+#undef CONCURRENT_HASH_TABLE_TYPE
+#undef CONCURRENT_HASH_TABLE_TEMPLATE
@@ -3,6 +3,7 @@
 #include "core/common.h"
 #include "core/logger.h"
 #include "core/types.h"
+#include "core/allocator.h"
 #include "math/common.h"
 #include "platform/platform.h"
 
@@ -13,6 +14,8 @@ struct DynamicArray
     u64 size;
     u64 capacity;
 
+    Allocator* allocator;
+
     T& operator[](const u64 index)
     {
         gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %)", index, size);
@@ -27,26 +30,29 @@ struct DynamicArray
 };
 
 template <typename T>
-inline DynamicArray<T> make(Type<DynamicArray<T>>, u64 start_cap = 16)
+inline DynamicArray<T> make(Type<DynamicArray<T>>, u64 start_cap = 16, Allocator* allocator = nullptr)
 {
     DynamicArray<T> arr;
 
+    arr.allocator = allocator;
     arr.capacity = start_cap;
     arr.size = 0;
-    arr.data = (T*) platform_allocate(arr.capacity * sizeof(T));
+    arr.data = (T*) allocator_allocate(arr.allocator, arr.capacity * sizeof(T), alignof(T));
     gn_assert_with_message(arr.data, "Could not allocate data for array!");
 
     return arr;
 }
 
+// Copy uses the same allocator as the original
 template <typename T>
 inline DynamicArray<T> copy(const DynamicArray<T>& other)
 {
     DynamicArray<T> arr;
 
+    arr.allocator = other.allocator;
     arr.capacity = other.capacity;
     arr.size = other.size;
-    arr.data = (T*) platform_allocate(arr.capacity * sizeof(T));
+    arr.data = (T*) allocator_allocate(arr.allocator, arr.capacity * sizeof(T), alignof(T));
     gn_assert_with_message(arr.data, "Could not allocate data for array!");
 
     for (u64 i = 0; i < arr.size; i++)
@@ -58,7 +64,7 @@ inline DynamicArray<T> copy(const DynamicArray<T>& other)
 template <typename T>
 inline void free(DynamicArray<T>& arr)
 {
-    platform_free(arr.data);
+    allocator_free(arr.allocator, arr.data, arr.capacity * sizeof(T), alignof(T));
 
     arr.data = nullptr;
     arr.capacity = arr.size = 0;
@@ -91,7 +97,7 @@ inline void clear_with_free(DynamicArray<T>& arr)
 template <typename T>
 inline void resize(DynamicArray<T>& arr, u64 new_capacity)
 {
-    T* new_data = (T*) platform_reallocate(arr.data, new_capacity * sizeof(T));
+    T* new_data = (T*) allocator_reallocate(arr.allocator, arr.data, arr.capacity * sizeof(T), new_capacity * sizeof(T), alignof(T));
     gn_assert_with_message(new_data, "Could not reallocate data for array!");
 
     arr.capacity = new_capacity;
@@ -102,7 +108,7 @@ template <typename T>
 inline DynamicArray<T>& append(DynamicArray<T>& arr, const T& elem)
 {
     if (arr.size >= arr.capacity)
-        resize(arr, max(2 * arr.capacity, 16ui64));
+        resize(arr, max(2 * arr.capacity, 16ull));
     
     arr.data[arr.size++] = elem;
     return arr;
@@ -126,7 +132,7 @@ inline DynamicArray<T>& insert(DynamicArray<T>& arr, u64 index, const T& elem)
     gn_assert_with_message(index < arr.size,  "Trying to insert at an out of bounds index! (index: %, array size: %)", index, arr.size);
 
     if (arr.size >= arr.capacity)
-        resize(arr, max(2 * arr.capacity, 16ui64));
+        resize(arr, max(2 * arr.capacity, 16ull));
 
     // Move all values ahead by 1 index    
     for (u64 i = arr.size; i > index; i--)
@@ -176,6 +182,103 @@ inline T remove_swap(DynamicArray<T>& arr, u64 index)
     return removed;
 }
 
+// Indices have to be sorted in ascending order, repeated indices are only removed once.
+// Keeps the order of the remaining elements and moves each run between removed indices once.
+template <typename T>
+inline void remove_indices(DynamicArray<T>& arr, const u64* sorted_indices, u64 count)
+{
+    if (count == 0)
+        return;
+
+    gn_assert_with_message(sorted_indices[count - 1] < arr.size, "Trying to remove from an out of bounds index! (index: %, array size: %)", sorted_indices[count - 1], arr.size);
+
+    u64 write_index = sorted_indices[0];
+
+    u64 i = 0;
+    while (i < count)
+    {
+        const u64 index = sorted_indices[i];
+
+        // Skip over repeats of the same index
+        while (i < count && sorted_indices[i] == index)
+            i++;
+
+        gn_assert_with_message(i == count || sorted_indices[i] > index, "Indices to remove aren't sorted! (index: %, previous index: %)", sorted_indices[i], index);
+
+        // Elements between this index and the next one to remove get kept
+        const u64 run_start = index + 1;
+        const u64 run_end   = (i < count) ? sorted_indices[i] : arr.size;
+        const u64 run_size  = run_end - run_start;
+
+        platform_move_memory(arr.data + write_index, arr.data + run_start, run_size * sizeof(T));
+        write_index += run_size;
+    }
+
+    arr.size = write_index;
+}
+
+template <typename T>
+inline void remove_indices(DynamicArray<T>& arr, const DynamicArray<u64>& sorted_indices)
+{
+    remove_indices(arr, sorted_indices.data, sorted_indices.size);
+}
+
+// Removes every element the predicate returns true for, keeps the order of the rest
+template <typename T, typename Predicate>
+inline u64 remove_if(DynamicArray<T>& arr, Predicate predicate)
+{
+    u64 write_index = 0;
+    u64 run_start = 0;
+
+    for (u64 i = 0; i < arr.size; i++)
+    {
+        if (!predicate(arr.data[i]))
+            continue;
+
+        // Move the run of kept elements before this one
+        const u64 run_size = i - run_start;
+        if (write_index != run_start)
+            platform_move_memory(arr.data + write_index, arr.data + run_start, run_size * sizeof(T));
+
+        write_index += run_size;
+        run_start = i + 1;
+    }
+
+    const u64 run_size = arr.size - run_start;
+    if (write_index != run_start)
+        platform_move_memory(arr.data + write_index, arr.data + run_start, run_size * sizeof(T));
+
+    const u64 removed_count = arr.size - (write_index + run_size);
+    arr.size = write_index + run_size;
+
+    return removed_count;
+}
+
+// Same as remove_indices but fills the holes with elements from the end, doesn't keep the order
+template <typename T>
+inline void remove_swap_many(DynamicArray<T>& arr, const u64* sorted_indices, u64 count)
+{
+    // Going from the back means the last element is never one that still has to be removed
+    for (u64 i = count; i > 0; i--)
+    {
+        const u64 index = sorted_indices[i - 1];
+
+        if (i < count && index == sorted_indices[i])
+            continue;
+
+        gn_assert_with_message(index < arr.size, "Trying to remove from an out of bounds index! (index: %, array size: %)", index, arr.size);
+
+        arr.size--;
+        arr.data[index] = arr.data[arr.size];
+    }
+}
+
+template <typename T>
+inline void remove_swap_many(DynamicArray<T>& arr, const DynamicArray<u64>& sorted_indices)
+{
+    remove_swap_many(arr, sorted_indices.data, sorted_indices.size);
+}
+
 template <typename T>
 inline u64 find(const DynamicArray<T>& arr, const T& needle)
 {
@@ -1,57 +1,137 @@
 #pragma once
 
+#include <new>
+#include <type_traits>
+#include "core/types.h"
+
+// By default a Function is just a function pointer, lambdas without captures
+// convert to it. Callbacks that need captures opt into InlineSize bytes of
+// inline storage instead, it never allocates. Captures have to fit and be
+// trivially copyable, which keeps the Function itself trivially copyable so
+// it can be memcpy'd around by containers.
+
+#define FUNCTION_INLINE_ALIGNMENT 16
+
 // Can't make a function with a simple type
-template <typename Type>
+template <typename Type, u64 InlineSize = 0>
 struct Function
 {
     Function() = delete;
 };
 
 template <typename RetType, typename... Args>
-struct Function <RetType (Args...)>
+struct Function <RetType (Args...), 0>
 {
     using FuncType = RetType (*)(Args...);
     FuncType _function;
 
     Function()
-    {}
-    
-    Function(FuncType function)
-    :   _function(function)
+    :   _function(nullptr)
     {
     }
 
-    Function(const Function& other)
-    :   _function(other._function)
+    Function(FuncType function)
+    :   _function(function)
     {
     }
-    
-    Function(Function&& other)
-    :   _function(other._function)
+
+    template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Function>>>
+    Function(Callable callable)
+    :   _function(callable)
     {
+        static_assert(std::is_convertible_v<Callable, FuncType>, "Lambdas with captures need a Function with inline storage!");
     }
 
+    Function(const Function& other) = default;
+    Function(Function&& other) = default;
+
     RetType operator()(Args... args)
     {
         return _function(args...);
     }
 
-    Function& operator=(const Function& other)
+    Function& operator=(const Function& other) = default;
+    Function& operator=(Function&& other) = default;
+
+    // Conversion operator
+    operator bool() const
     {
-        _function = other._function;
-        return *this;
+        return _function != nullptr;
     }
 
-    Function& operator=(Function&& other)
+};
+
+// Everything goes through the trampoline, plain functions are kept in the storage
+// like any other callable, so calling never has to check which kind it is
+template <typename RetType, typename... Args, u64 InlineSize>
+struct Function <RetType (Args...), InlineSize>
+{
+    using FuncType = RetType (*)(Args...);
+    using InvokeType = RetType (*)(void* storage, Args...);
+
+    static_assert(InlineSize >= sizeof(FuncType), "Inline storage has to at least fit a function pointer!");
+
+    InvokeType _invoke;
+    alignas(FUNCTION_INLINE_ALIGNMENT) u8 _storage[InlineSize];
+
+    Function()
+    :   _invoke(nullptr)
     {
-        _function = other._function;
-        return *this;
     }
 
+    Function(FuncType function)
+    :   _invoke(nullptr)
+    {
+        if (function)
+            store(function);
+    }
+
+    template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Function>>>
+    Function(Callable callable)
+    :   _invoke(nullptr)
+    {
+        if constexpr (std::is_convertible_v<Callable, FuncType>)
+        {
+            // No captures so it's just a function
+            store((FuncType) callable);
+        }
+        else
+        {
+            store(callable);
+        }
+    }
+
+    Function(const Function& other) = default;
+    Function(Function&& other) = default;
+
+    RetType operator()(Args... args)
+    {
+        return _invoke(_storage, args...);
+    }
+
+    Function& operator=(const Function& other) = default;
+    Function& operator=(Function&& other) = default;
+
     // Conversion operator
     operator bool() const
     {
-        return _function != nullptr;
+        return _invoke != nullptr;
+    }
+
+    template <typename Callable>
+    void store(const Callable& callable)
+    {
+        static_assert(sizeof(Callable) <= InlineSize, "Captures don't fit in the function's inline storage!");
+        static_assert(alignof(Callable) <= FUNCTION_INLINE_ALIGNMENT, "Captures need a larger alignment than the function's inline storage has!");
+        static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>, "Captures have to be trivially copyable so functions can be moved around freely!");
+
+        new (_storage) Callable(callable);
+        _invoke = [](void* storage, Args... args) -> RetType
+        {
+            return (*(Callable*) storage)(args...);
+        };
     }
 
-};
\ No newline at end of file
+};
+
+#undef FUNCTION_INLINE_ALIGNMENT
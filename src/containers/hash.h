@@ -1,10 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <emmintrin.h>
 #include "core/types.h"
+#include "core/compiler_utils.h"
 #include "string.h"
 
-using Hash = u32;
+#if defined(GN_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+using Hash = u64;
 
 template<typename T>
 struct Hasher
@@ -12,22 +19,318 @@ struct Hasher
     inline Hash operator()(T const& key);
 };
 
-constexpr Hash bytes[4] = {
-    0x000000FF,
-    0x0000FF00,
-    0x00FF0000,
-    0xFF000000
+// Byte hashing is based on wyhash for short keys and on the xxh3 stripe
+// accumulator for long keys: https://github.com/wangyi-fudan/wyhash
+// Every path has a scalar constexpr twin that gives the exact same result,
+// that's what's used for hashing string literals at compile time.
+
+namespace HashInternal
+{
+
+constexpr u64 secret[8] = {
+    0xA0761D6478BD642F, 0xE7037ED1A0B428DB,
+    0x8EBC6AF09C88C6E3, 0x589965CC75374CC3,
+    0x1D8E4E27C47D124F, 0x9E3779B97F4A7C15,
+    0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9,
 };
 
+constexpr u64 prime_32 = 0x9E3779B1;
+
+constexpr u64 stripe_size     = 64;         // 8 lanes of u64
+constexpr u64 block_stripes   = 16;         // Accumulators get scrambled after every block
+constexpr u64 long_key_length = 256;        // Keys longer than this use the stripe accumulator
+
+// Full 64x64 -> 128 bit multiply, folded back to 64 bits
+constexpr u64 mix_constexpr(const u64 a, const u64 b)
+{
+    const u64 a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    const u64 b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+
+    const u64 lo_lo = a_lo * b_lo;
+    const u64 hi_lo = a_hi * b_lo;
+    const u64 lo_hi = a_lo * b_hi;
+    const u64 hi_hi = a_hi * b_hi;
+
+    const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    const u64 lo = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    const u64 hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+
+    return lo ^ hi;
+}
+
+GN_FORCE_INLINE u64 mix(const u64 a, const u64 b)
+{
+#if defined(GN_COMPILER_MSVC)
+    u64 hi;
+    const u64 lo = _umul128(a, b, &hi);
+    return lo ^ hi;
+#elif defined(GN_COMPILER_GCC) || defined(GN_COMPILER_CLANG)
+    const unsigned __int128 product = (unsigned __int128) a * b;
+    return (u64) product ^ (u64) (product >> 64);
+#else
+    return mix_constexpr(a, b);
+#endif
+}
+
+// Little endian reads
+constexpr u64 read_u64_constexpr(const char* ptr)
+{
+    u64 result = 0;
+    for (u32 i = 0; i < 8; i++)
+        result |= (u64) (u8) ptr[i] << (i * 8);
+
+    return result;
+}
+
+constexpr u64 read_u32_constexpr(const char* ptr)
+{
+    u64 result = 0;
+    for (u32 i = 0; i < 4; i++)
+        result |= (u64) (u8) ptr[i] << (i * 8);
+
+    return result;
+}
+
+GN_FORCE_INLINE u64 read_u64(const char* ptr)
+{
+    u64 result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+GN_FORCE_INLINE u64 read_u32(const char* ptr)
+{
+    u32 result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+constexpr u64 finalize(const u64 h)
+{
+    // splitmix64 finalizer
+    u64 z = h;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+// xxh3 style accumulation, each lane gets the product of the
+// two halves of its input and the neighbouring lane gets the raw input
+constexpr void accumulate_stripe_constexpr(u64 (&acc)[8], const char* ptr)
+{
+    for (u32 lane = 0; lane < 8; lane++)
+    {
+        const u64 data = read_u64_constexpr(ptr + lane * 8);
+        const u64 key  = data ^ secret[lane];
+
+        acc[lane ^ 1] += data;
+        acc[lane]     += (key & 0xFFFFFFFF) * (key >> 32);
+    }
+}
+
+constexpr void scramble_constexpr(u64 (&acc)[8])
+{
+    for (u32 lane = 0; lane < 8; lane++)
+        acc[lane] = ((acc[lane] ^ (acc[lane] >> 47)) ^ secret[7 - lane]) * prime_32;
+}
+
+GN_FORCE_INLINE void accumulate_stripe(__m128i (&acc)[4], const char* ptr)
+{
+    for (u32 i = 0; i < 4; i++)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*) (ptr + i * 16));
+        const __m128i key  = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*) (secret + i * 2)));
+
+        const __m128i product = _mm_mul_epu32(key, _mm_srli_epi64(key, 32));
+        const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+        acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swapped));
+    }
+}
+
+GN_FORCE_INLINE void scramble(__m128i (&acc)[4])
+{
+    const __m128i prime = _mm_set1_epi32((s32) prime_32);
+
+    for (u32 i = 0; i < 4; i++)
+    {
+        // Secret is used in reverse order, same as the scalar version
+        const __m128i key = _mm_set_epi64x((s64) secret[6 - i * 2], (s64) secret[7 - i * 2]);
+
+        __m128i value = _mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47));
+        value = _mm_xor_si128(value, key);
+
+        // SSE2 only has 32x32 -> 64 bit multiplies, so multiply the halves separately
+        const __m128i lo = _mm_mul_epu32(value, prime);
+        const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+        acc[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    }
+}
+
+constexpr u64 merge_accumulators(const u64 (&acc)[8], const u64 length)
+{
+    u64 result = length * secret[0];
+    for (u32 i = 0; i < 4; i++)
+        result += mix_constexpr(acc[2 * i] ^ secret[2 * i], acc[2 * i + 1] ^ secret[2 * i + 1]);
+
+    return finalize(result);
+}
+
+constexpr u64 hash_long_constexpr(const char* buffer, const u64 length)
+{
+    u64 acc[8] = {
+        secret[0], secret[1], secret[2], secret[3],
+        secret[4], secret[5], secret[6], secret[7],
+    };
+
+    const u64 num_stripes = (length - 1) / stripe_size;
+    for (u64 i = 0; i < num_stripes; i++)
+    {
+        accumulate_stripe_constexpr(acc, buffer + i * stripe_size);
+
+        if ((i + 1) % block_stripes == 0)
+            scramble_constexpr(acc);
+    }
+
+    // Last stripe always ends at the end of the buffer (might overlap the previous one)
+    accumulate_stripe_constexpr(acc, buffer + length - stripe_size);
+
+    return merge_accumulators(acc, length);
+}
+
+inline u64 hash_long(const char* buffer, const u64 length)
+{
+    __m128i acc[4];
+    for (u32 i = 0; i < 4; i++)
+        acc[i] = _mm_loadu_si128((const __m128i*) (secret + i * 2));
+
+    const u64 num_stripes = (length - 1) / stripe_size;
+    for (u64 i = 0; i < num_stripes; i++)
+    {
+        accumulate_stripe(acc, buffer + i * stripe_size);
+
+        if ((i + 1) % block_stripes == 0)
+            scramble(acc);
+    }
+
+    // Last stripe always ends at the end of the buffer (might overlap the previous one)
+    accumulate_stripe(acc, buffer + length - stripe_size);
+
+    u64 lanes[8];
+    for (u32 i = 0; i < 4; i++)
+        _mm_storeu_si128((__m128i*) (lanes + i * 2), acc[i]);
+
+    return merge_accumulators(lanes, length);
+}
+
+} // namespace HashInternal
+
+// Use this for hashing literals at compile time, gives the same result as hash_bytes()
+constexpr Hash hash_bytes_constexpr(const char* buffer, const u64 length)
+{
+    using namespace HashInternal;
+
+    if (length > long_key_length)
+        return hash_long_constexpr(buffer, length);
+
+    u64 seed = secret[0];
+    u64 a = 0, b = 0;
+
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            const u64 offset = (length >> 3) << 2;
+            a = (read_u32_constexpr(buffer) << 32) | read_u32_constexpr(buffer + offset);
+            b = (read_u32_constexpr(buffer + length - 4) << 32) | read_u32_constexpr(buffer + length - 4 - offset);
+        }
+        else if (length > 0)
+        {
+            a = ((u64) (u8) buffer[0] << 16) | ((u64) (u8) buffer[length >> 1] << 8) | (u64) (u8) buffer[length - 1];
+        }
+    }
+    else
+    {
+        u64 remaining = length;
+        const char* ptr = buffer;
+
+        while (remaining > 16)
+        {
+            seed = mix_constexpr(read_u64_constexpr(ptr) ^ secret[1], read_u64_constexpr(ptr + 8) ^ seed);
+            ptr += 16;
+            remaining -= 16;
+        }
+
+        // Last 16 bytes of the buffer
+        a = read_u64_constexpr(ptr + remaining - 16);
+        b = read_u64_constexpr(ptr + remaining - 8);
+    }
+
+    return finalize(mix_constexpr(a ^ secret[1], b ^ seed) ^ length);
+}
+
+inline Hash hash_bytes(const void* data, const u64 length)
+{
+    using namespace HashInternal;
+
+    const char* buffer = (const char*) data;
+
+    if (length > long_key_length)
+        return hash_long(buffer, length);
+
+    u64 seed = secret[0];
+    u64 a = 0, b = 0;
+
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            const u64 offset = (length >> 3) << 2;
+            a = (read_u32(buffer) << 32) | read_u32(buffer + offset);
+            b = (read_u32(buffer + length - 4) << 32) | read_u32(buffer + length - 4 - offset);
+        }
+        else if (length > 0)
+        {
+            a = ((u64) (u8) buffer[0] << 16) | ((u64) (u8) buffer[length >> 1] << 8) | (u64) (u8) buffer[length - 1];
+        }
+    }
+    else
+    {
+        u64 remaining = length;
+        const char* ptr = buffer;
+
+        while (remaining > 16)
+        {
+            seed = mix(read_u64(ptr) ^ secret[1], read_u64(ptr + 8) ^ seed);
+            ptr += 16;
+            remaining -= 16;
+        }
+
+        // Last 16 bytes of the buffer
+        a = read_u64(ptr + remaining - 16);
+        b = read_u64(ptr + remaining - 8);
+    }
+
+    return finalize(mix(a ^ secret[1], b ^ seed) ^ length);
+}
+
+// Strong mixer for integer keys, every input bit affects every output bit
+constexpr Hash hash_integer(const u64 key)
+{
+    return HashInternal::finalize(key ^ HashInternal::secret[0]);
+}
+
 template <>
 struct Hasher<f32>
 {
     inline Hash operator()(f32 const& key) const
     {
-        Hash hash = *(Hash*)(&key);
-        Hash shuffled = (hash >> 16) | (hash << 16);
+        // -0.0f == 0.0f so they need to hash to the same value
+        u32 bits = 0;
+        if (key != 0.0f)
+            memcpy(&bits, &key, sizeof(bits));
 
-        return shuffled ^ 0xE8BF6CDF;
+        return hash_integer(bits);
     }
 };
 
@@ -36,19 +339,7 @@ struct Hasher<s32>
 {
     inline Hash operator()(s32 const& key) const
     {
-        Hash hash = *(Hash*)(&key);
-
-        // 00 00 00 FF -> 00 FF 00 00   << 16
-        // 00 00 FF 00 -> 00 00 00 FF   >> 8
-        // 00 FF 00 00 -> FF 00 00 00   << 8
-        // FF 00 00 00 -> 00 00 FF 00   >> 16
-        
-        Hash shuffled = ((hash & bytes[0]) << 16) |
-                        ((hash & bytes[1]) >>  8) |
-                        ((hash & bytes[2]) <<  8) |
-                        ((hash & bytes[3]) >> 16);
-
-        return shuffled;
+        return hash_integer((u32) key);
     }
 };
 
@@ -57,25 +348,7 @@ struct Hasher<u64>
 {
     inline Hash operator()(u64 const& key) const
     {
-        Hash hash1 = (((Hash*)(&key))[0]);
-        Hash hash2 = (((Hash*)(&key))[1]);
-
-        // 00 00 00 FF -> 00 FF 00 00   << 16
-        // 00 00 FF 00 -> 00 00 00 FF   >> 8
-        // 00 FF 00 00 -> FF 00 00 00   << 8
-        // FF 00 00 00 -> 00 00 FF 00   >> 16
-        
-        Hash shuffled1 = ((hash1 & bytes[0]) << 16) |
-                         ((hash1 & bytes[1]) >>  8) |
-                         ((hash1 & bytes[2]) <<  8) |
-                         ((hash1 & bytes[3]) >> 16);
-
-        Hash shuffled2 = ((hash2 & bytes[0]) << 16) |
-                         ((hash2 & bytes[1]) >>  8) |
-                         ((hash2 & bytes[2]) <<  8) |
-                         ((hash2 & bytes[3]) >> 16);
-
-        return shuffled1 ^ shuffled2;
+        return hash_integer(key);
     }
 };
 
@@ -84,52 +357,56 @@ struct Hasher<void*>
 {
     inline Hash operator()(void* const& key) const
     {
-        u64 asU64 = (u64) key;
-        return Hasher<u64>()(asU64);
+        return hash_integer((u64) key);
     }
 };
 
-static inline Hash HashCharBuffer(char const* buffer, const u64 length)
+template<>
+struct Hasher<String>
 {
-    Hash const* ptr = (Hash*) buffer;
-    u64 count = length / 4;
-    u32 rem = length % 4;
-
-    Hash hash = 0x8BDC195DF;
-    while (count)
+    inline Hash operator()(String const& key) const
     {
-        const Hash val = *ptr;
-        
-        hash = hash + hash * val * val * (count * count + 1);
-        hash = ((hash & bytes[0]) << 16) |
-               ((hash & bytes[1]) >>  8) |
-               ((hash & bytes[2]) <<  8) |
-               ((hash & bytes[3]) >> 16);
-
-        count--;
-        ptr++;
+        return hash_bytes(key.data, key.size);
     }
+};
 
-    {   // Hash the remaining chars
-        const u32 shift = (4 - rem) * 8;
-        const u32 mask = (shift < 32u) ? (0xFFFFFFFF << shift) : 0u;
-        const Hash val = (*ptr) & mask;
-        
-        hash = hash + hash * val * val;
-        hash = ((hash & bytes[0]) << 16) |
-               ((hash & bytes[1]) >>  8) |
-               ((hash & bytes[2]) <<  8) |
-               ((hash & bytes[3]) >> 16);
-    }
+// String with its hash cached alongside it. The hash is the same as Hasher<String>
+// so it can be used to look up tables that are keyed on String.
+struct HashedString
+{
+    String string;
+    Hash   hash;
+};
+
+template <Hash value>
+struct HashConstant
+{
+    static constexpr Hash hash = value;
+};
+
+inline HashedString hashed(const String str)
+{
+    return HashedString { str, hash_bytes(str.data, str.size) };
+}
 
-    return hash;
+// Only works with string literals, the hash is computed at compile time
+#define hashed_ref(literal) (HashedString { String { (char*) (literal), sizeof(literal) - 1, nullptr }, HashConstant<hash_bytes_constexpr((literal), sizeof(literal) - 1)>::hash })
+
+inline bool operator==(const HashedString& str1, const HashedString& str2)
+{
+    return str1.hash == str2.hash && str1.string == str2.string;
+}
+
+inline bool operator!=(const HashedString& str1, const HashedString& str2)
+{
+    return !(str1 == str2);
 }
 
 template<>
-struct Hasher<String>
+struct Hasher<HashedString>
 {
-    inline Hash operator()(String const& key) const
+    inline Hash operator()(HashedString const& key) const
     {
-        return HashCharBuffer(key.data, key.size);
+        return key.hash;
     }
-};
\ No newline at end of file
+};
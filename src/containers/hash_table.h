@@ -1,33 +1,46 @@
 #pragma once
 
 #include <cstdlib>
+#include <emmintrin.h>
 #include "core/types.h"
 #include "core/common.h"
+#include "core/compiler_utils.h"
+#include "core/allocator.h"
 #include "math/common.h"
 #include "hash.h"
 
 #define HASH_TABLE_TEMPLATE template <typename KeyType, typename ValueType, typename Hasher = Hasher<KeyType>>
 #define HASH_TABLE_MAX_LOAD_FACTOR 0.75f
+#define HASH_TABLE_MAX_TOMBSTONE_FACTOR 0.25f
+#define HASH_TABLE_GROUP_SIZE 16
+
+// Swiss table style layout. Every slot has a 1 byte control value and the
+// slots are probed in groups of 16 using SSE2 to compare all the control bytes
+// at once. Alive slots store the lower 7 bits of their hash in the control byte
+// so most mismatches get rejected without touching the keys at all.
+// Alive slots are also tracked in a bitmask (1 bit per slot) so walking
+// over the elements skips 64 slots at a time instead of checking every control byte.
 
 HASH_TABLE_TEMPLATE
 struct HashTable
 {
-    enum struct State : u8
-    {
-        EMPTY,
-        TOMBSTONE,
-        ALIVE
-    };
+    using Control = s8;
 
-    State*     states;
-    Hash*      hashes;
+    // Alive slots have the high bit cleared
+    static constexpr Control EMPTY     = (Control) 0b10000000;
+    static constexpr Control TOMBSTONE = (Control) 0b11111110;
+
+    Control*   controls;
     KeyType*   keys;
     ValueType* values;
+    u64*       occupied;    // Bit set for every alive slot
 
-    u32 filled;
-    u32 capacity;
+    u32 count;      // Alive slots
+    u32 tombstones;
+    u32 capacity;   // Always a power of 2 and a multiple of the group size
 
     Hasher hasher;
+    Allocator* allocator;
 };
 
 HASH_TABLE_TEMPLATE
@@ -35,99 +48,277 @@ struct HashTableElement
 {
     const HashTable<KeyType, ValueType, Hasher>* table;
     u32 index;
-    
+
     // Conversions
     inline operator bool() const
     {
-        using HashTable = HashTable<KeyType, ValueType, Hasher>;
-        using State     = HashTable::State;
-
         gn_assert_with_message(table, "Element doesn't point to a valid hash table!");
-        return index < table->capacity && table->states[index] == State::ALIVE;
+        return index < table->capacity && table->controls[index] >= 0;
     }
 
     // Getters
     inline KeyType& key() const
     {
-        using HashTable = HashTable<KeyType, ValueType, Hasher>;
-        using State     = HashTable::State;
-
         gn_assert_with_message(table, "Element doesn't point to a valid hash table!");
         gn_assert_with_message(index < table->capacity, "Element not valid!");
-        gn_assert_with_message(table->states[index] == State::ALIVE, "Element at index % is not alive! (status %)", index, (u32) table->states[index]);
+        gn_assert_with_message(table->controls[index] >= 0, "Element at index % is not alive! (control %)", index, (s32) table->controls[index]);
         return table->keys[index];
     }
 
     inline ValueType& value() const
     {
-        using HashTable = HashTable<KeyType, ValueType, Hasher>;
-        using State     = HashTable::State;
-
         gn_assert_with_message(table, "Element doesn't point to a valid hash table!");
         gn_assert_with_message(index < table->capacity, "Element not valid!");
-        gn_assert_with_message(table->states[index] == State::ALIVE, "Element at index % is not alive! (status %)", index, (u32) table->states[index]);
+        gn_assert_with_message(table->controls[index] >= 0, "Element at index % is not alive! (control %)", index, (s32) table->controls[index]);
         return table->values[index];
     }
 };
 
+// Walks the alive elements using the bitmask:
+// for (auto elem : table) { use(elem.key(), elem.value()); }
+// Elements can be freed while iterating but not put or removed.
+HASH_TABLE_TEMPLATE
+struct HashTableIterator
+{
+    const HashTable<KeyType, ValueType, Hasher>* table;
+    u32 index;
+    u64 remaining;      // Bits of the current bitmask word that haven't been visited yet
+
+    inline HashTableElement<KeyType, ValueType, Hasher> operator*() const
+    {
+        return HashTableElement<KeyType, ValueType, Hasher> { table, index };
+    }
+
+    inline HashTableIterator& operator++()
+    {
+        remaining &= remaining - 1;
+
+        u32 word = index / 64;
+        const u32 word_count = (table->capacity + 63) / 64;
+
+        while (!remaining)
+        {
+            if (++word >= word_count)
+            {
+                index = table->capacity;
+                return *this;
+            }
+
+            remaining = table->occupied[word];
+        }
+
+        index = word * 64 + (u32) GN_COUNT_TRAILING_ZEROS_64(remaining);
+        return *this;
+    }
+
+    inline bool operator!=(const HashTableIterator& other) const
+    {
+        return index != other.index;
+    }
+};
+
+HASH_TABLE_TEMPLATE
+inline HashTableIterator<KeyType, ValueType, Hasher> begin(const HashTable<KeyType, ValueType, Hasher>& table)
+{
+    HashTableIterator<KeyType, ValueType, Hasher> it = { &table, 0, 0 };
+    if (table.capacity == 0)
+        return it;
+
+    it.remaining = table.occupied[0];
+    if (it.remaining)
+    {
+        it.index = (u32) GN_COUNT_TRAILING_ZEROS_64(it.remaining);
+        return it;
+    }
+
+    // First word is empty, ++ moves on to the next one with an alive slot
+    return ++it;
+}
+
 HASH_TABLE_TEMPLATE
-inline HashTable<KeyType, ValueType, Hasher> make(Type<HashTable<KeyType, ValueType, Hasher>>, u32 start_cap = 32)
+inline HashTableIterator<KeyType, ValueType, Hasher> end(const HashTable<KeyType, ValueType, Hasher>& table)
+{
+    return HashTableIterator<KeyType, ValueType, Hasher> { &table, table.capacity, 0 };
+}
+
+// Position of the first group to probe
+static inline u32 hash_table_h1(const Hash hash)
+{
+    return (u32) (hash >> 7);
+}
+
+// Control byte stored for an alive slot
+static inline s8 hash_table_h2(const Hash hash)
+{
+    return (s8) (hash & 0x7F);
+}
+
+// Returns a mask with a bit set for every control byte in the group equal to control
+static inline u32 hash_table_group_match(const s8* group, const s8 control)
+{
+    const __m128i controls = _mm_loadu_si128((const __m128i*) group);
+    return (u32) _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control)));
+}
+
+// Returns a mask with a bit set for every empty or tombstone slot in the group
+static inline u32 hash_table_group_match_free(const s8* group)
+{
+    // Only the high bit of each byte is used by movemask
+    const __m128i controls = _mm_loadu_si128((const __m128i*) group);
+    return (u32) _mm_movemask_epi8(controls);
+}
+
+static inline u32 hash_table_occupied_word_count(u32 capacity)
+{
+    return (capacity + 63) / 64;
+}
+
+HASH_TABLE_TEMPLATE
+static inline void hash_table_mark_alive(HashTable<KeyType, ValueType, Hasher>& table, u32 index)
+{
+    table.occupied[index / 64] |= 1ull << (index % 64);
+}
+
+HASH_TABLE_TEMPLATE
+static inline void hash_table_mark_free(HashTable<KeyType, ValueType, Hasher>& table, u32 index)
+{
+    table.occupied[index / 64] &= ~(1ull << (index % 64));
+}
+
+// Rebuilds the bitmask from the control bytes, a group at a time
+HASH_TABLE_TEMPLATE
+static inline void hash_table_rebuild_occupied(HashTable<KeyType, ValueType, Hasher>& table)
+{
+    platform_zero_memory(table.occupied, hash_table_occupied_word_count(table.capacity) * sizeof(u64));
+
+    for (u32 group_start = 0; group_start < table.capacity; group_start += HASH_TABLE_GROUP_SIZE)
+    {
+        const u64 alive = ~hash_table_group_match_free(table.controls + group_start) & 0xFFFF;
+        table.occupied[group_start / 64] |= alive << (group_start % 64);
+    }
+}
+
+// Groups are probed quadratically (triangular numbers) which
+// visits every group when the number of groups is a power of 2
+HASH_TABLE_TEMPLATE
+static inline u32 hash_table_find_free_slot(const HashTable<KeyType, ValueType, Hasher>& table, const Hash hash)
+{
+    const u32 group_mask = (table.capacity / HASH_TABLE_GROUP_SIZE) - 1;
+    u32 group = hash_table_h1(hash) & group_mask;
+
+    for (u32 step = 1; step <= group_mask + 1; step++)
+    {
+        const u32 free_slots = hash_table_group_match_free(table.controls + group * HASH_TABLE_GROUP_SIZE);
+        if (free_slots)
+            return group * HASH_TABLE_GROUP_SIZE + GN_COUNT_TRAILING_ZEROS_32(free_slots);
+
+        group = (group + step) & group_mask;
+    }
+
+    gn_assert_with_message(false, "Ran out of entries in hash table to place element! (capacity: %)", table.capacity);
+    return table.capacity;
+}
+
+// Where each array starts in the table's single allocation
+struct HashTableLayout
+{
+    u64 keys_offset;
+    u64 values_offset;
+    u64 occupied_offset;
+    u64 size;
+};
+
+static inline u64 hash_table_align_up(u64 offset, u64 alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+HASH_TABLE_TEMPLATE
+static constexpr u64 hash_table_alignment()
+{
+    return max(max((u64) alignof(KeyType), (u64) alignof(ValueType)), allocator_default_alignment);
+}
+
+HASH_TABLE_TEMPLATE
+static inline HashTableLayout hash_table_layout(u32 capacity)
+{
+    using Control = typename HashTable<KeyType, ValueType, Hasher>::Control;
+
+    // Every array starts aligned for its own type
+    HashTableLayout layout;
+    layout.keys_offset     = hash_table_align_up((u64) capacity * sizeof(Control), alignof(KeyType));
+    layout.values_offset   = hash_table_align_up(layout.keys_offset + (u64) capacity * sizeof(KeyType), alignof(ValueType));
+    layout.occupied_offset = hash_table_align_up(layout.values_offset + (u64) capacity * sizeof(ValueType), alignof(u64));
+    layout.size            = layout.occupied_offset + hash_table_occupied_word_count(capacity) * sizeof(u64);
+
+    return layout;
+}
+
+HASH_TABLE_TEMPLATE
+static inline void hash_table_free_allocation(HashTable<KeyType, ValueType, Hasher>& table)
+{
+    const u64 size = hash_table_layout<KeyType, ValueType, Hasher>(table.capacity).size;
+    allocator_free(table.allocator, table.controls, size, hash_table_alignment<KeyType, ValueType, Hasher>());
+}
+
+// Uses the allocator that's already set on the table
+HASH_TABLE_TEMPLATE
+static inline void hash_table_allocate(HashTable<KeyType, ValueType, Hasher>& table, u32 capacity)
 {
     using HashTable = HashTable<KeyType, ValueType, Hasher>;
-    using State     = HashTable::State;
+    using Control   = typename HashTable::Control;
 
-    HashTable table;
+    table.capacity   = capacity;
+    table.count      = 0;
+    table.tombstones = 0;
 
-    table.capacity = max(start_cap, 2Ui32);
-    table.filled   = 0;
-    
-    const u64 size_in_bytes = table.capacity * (sizeof(State) + sizeof(Hash) + sizeof(KeyType) + sizeof(ValueType));
-    void* allocation = platform_allocate(size_in_bytes);
+    const HashTableLayout layout = hash_table_layout<KeyType, ValueType, Hasher>(table.capacity);
+    u8* allocation = (u8*) allocator_allocate(table.allocator, layout.size, hash_table_alignment<KeyType, ValueType, Hasher>());
     gn_assert_with_message(allocation, "Could not allocate data for hash table!");
 
-    table.states = (State*)     (allocation);
-    table.hashes = (Hash*)      (table.states + table.capacity);
-    table.keys   = (KeyType*)   (table.hashes + table.capacity);
-    table.values = (ValueType*) (table.keys   + table.capacity);
+    table.controls = (Control*)   (allocation);
+    table.keys     = (KeyType*)   (allocation + layout.keys_offset);
+    table.values   = (ValueType*) (allocation + layout.values_offset);
+    table.occupied = (u64*)       (allocation + layout.occupied_offset);
+}
+
+HASH_TABLE_TEMPLATE
+inline HashTable<KeyType, ValueType, Hasher> make(Type<HashTable<KeyType, ValueType, Hasher>>, u32 start_cap = 32, Allocator* allocator = nullptr)
+{
+    using HashTable = HashTable<KeyType, ValueType, Hasher>;
+
+    HashTable table;
+    table.allocator = allocator;
 
-    platform_set_memory(table.states, (int) State::EMPTY, table.capacity * sizeof(State));
+    hash_table_allocate(table, Math::next_power_of_2(max(start_cap, (u32) HASH_TABLE_GROUP_SIZE)));
+    platform_set_memory(table.controls, HashTable::EMPTY, table.capacity * sizeof(typename HashTable::Control));
+    platform_zero_memory(table.occupied, hash_table_occupied_word_count(table.capacity) * sizeof(u64));
 
     return table;
 }
 
+// Copy uses the same allocator as the original
 HASH_TABLE_TEMPLATE
 inline HashTable<KeyType, ValueType, Hasher> copy(const HashTable<KeyType, ValueType, Hasher>& other)
 {
     using HashTable = HashTable<KeyType, ValueType, Hasher>;
-    using State     = HashTable::State;
 
     HashTable table;
+    table.hasher    = other.hasher;
+    table.allocator = other.allocator;
 
-    table.capacity = other.capacity;
-    table.filled   = other.filled;
-    
-    const u64 size_in_bytes = table.capacity * (sizeof(State) + sizeof(Hash) + sizeof(KeyType) + sizeof(ValueType));
-    void* allocation = platform_allocate(size_in_bytes);
-    gn_assert_with_message(allocation, "Could not allocate data for hash table!");
+    hash_table_allocate(table, other.capacity);
+    table.count      = other.count;
+    table.tombstones = other.tombstones;
 
-    table.states = (State*)     (allocation);
-    table.hashes = (Hash*)      (table.states + table.capacity);
-    table.keys   = (KeyType*)   (table.hashes + table.capacity);
-    table.values = (ValueType*) (table.keys   + table.capacity);
+    // Copy control bytes and the bitmask
+    platform_copy_memory(table.controls, other.controls, table.capacity * sizeof(typename HashTable::Control));
+    platform_copy_memory(table.occupied, other.occupied, hash_table_occupied_word_count(table.capacity) * sizeof(u64));
 
-    // Copy states and hashes
-    platform_copy_memory(table.states, other.states, table.capacity * (sizeof(State) + sizeof(Hash)));
-
-    u32 remaining = table.filled;
-    for (u32 i = 0; remaining > 0 && i < table.capacity; i++)
+    for (auto elem : other)
     {
-        // Copy keys and values when required
-        if (table.states[i] == State::ALIVE)
-        {
-            table.keys[i]   = copy(other.keys[i]);
-            table.values[i] = copy(other.values[i]);
-            remaining--;
-        }
+        table.keys[elem.index]   = copy(elem.key());
+        table.values[elem.index] = copy(elem.value());
     }
 
     return table;
@@ -136,62 +327,37 @@ inline HashTable<KeyType, ValueType, Hasher> copy(const HashTable<KeyType, Value
 HASH_TABLE_TEMPLATE
 inline void free(HashTable<KeyType, ValueType, Hasher>& table)
 {
-    platform_free(table.states);
+    hash_table_free_allocation(table);
 
-    table.states = nullptr;
-    table.hashes = nullptr;
-    table.keys   = nullptr;
-    table.values = nullptr;
-    table.capacity = table.filled = 0;
+    table.controls = nullptr;
+    table.keys     = nullptr;
+    table.values   = nullptr;
+    table.occupied = nullptr;
+    table.capacity = table.count = table.tombstones = 0;
 }
 
 HASH_TABLE_TEMPLATE
 inline void free_keys(HashTable<KeyType, ValueType, Hasher>& table)
 {
-    using HashTable = HashTable<KeyType, ValueType, Hasher>;
-
-    u32 remaining = table.filled;
-    for (u32 i = 0; remaining > 0 && i < table.capacity; i++)
-    {
-        if (table.states[i] == HashTable::State::ALIVE)
-        {
-            free(table.keys[i]);
-            remaining--;
-        }
-    }
+    for (auto elem : table)
+        free(elem.key());
 }
 
 HASH_TABLE_TEMPLATE
 inline void free_values(HashTable<KeyType, ValueType, Hasher>& table)
 {
-    using HashTable = HashTable<KeyType, ValueType, Hasher>;
-    
-    u32 remaining = table.filled;
-    for (u32 i = 0; remaining > 0 && i < table.capacity; i++)
-    {
-        if (table.states[i] == HashTable::State::ALIVE)
-        {
-            free(table.values[i]);
-            remaining--;
-        }
-    }
+    for (auto elem : table)
+        free(elem.value());
 }
 
 HASH_TABLE_TEMPLATE
 inline void free_all(HashTable<KeyType, ValueType, Hasher>& table)
 {
-    using HashTable = HashTable<KeyType, ValueType, Hasher>;
-
     // Free keys and values
-    u32 remaining = table.filled;
-    for (u32 i = 0; remaining > 0 && i < table.capacity; i++)
+    for (auto elem : table)
     {
-        if (table.states[i] == HashTable::State::ALIVE)
-        {
-            free(table.keys[i]);
-            free(table.values[i]);
-            remaining--;
-        }
+        free(elem.key());
+        free(elem.value());
     }
 
     free(table);
@@ -200,86 +366,128 @@ inline void free_all(HashTable<KeyType, ValueType, Hasher>& table)
 HASH_TABLE_TEMPLATE
 void resize(HashTable<KeyType, ValueType, Hasher>& table, u32 new_capacity)
 {
-    gn_assert_with_message(new_capacity > table.capacity, "Table can't be resized to be smaller than before! (new_capacity: %, old_capacity: %)", new_capacity, table.capacity);
+    gn_assert_with_message((f32) table.count <= HASH_TABLE_MAX_LOAD_FACTOR * (f32) new_capacity, "Table can't be resized to be smaller than its elements allow! (new_capacity: %, element count: %)", new_capacity, table.count);
+    gn_assert_with_message((new_capacity & (new_capacity - 1)) == 0, "Hash table capacity has to be a power of 2! (new_capacity: %)", new_capacity);
 
     using HashTable = HashTable<KeyType, ValueType, Hasher>;
-    using State     = HashTable::State;
 
     HashTable new_table;
-    new_table.capacity = new_capacity;
-    new_table.filled   = table.filled;
+    new_table.hasher    = table.hasher;
+    new_table.allocator = table.allocator;
+
+    hash_table_allocate(new_table, new_capacity);
+    platform_set_memory(new_table.controls, HashTable::EMPTY, new_table.capacity * sizeof(typename HashTable::Control));
+    platform_zero_memory(new_table.occupied, hash_table_occupied_word_count(new_table.capacity) * sizeof(u64));
+
+    // Tombstones are dropped while copying
+    for (auto elem : table)
+    {
+        const Hash hash = new_table.hasher(elem.key());
+        const u32 index = hash_table_find_free_slot(new_table, hash);
+
+        new_table.controls[index] = hash_table_h2(hash);
+        new_table.keys[index]     = elem.key();
+        new_table.values[index]   = elem.value();
+        hash_table_mark_alive(new_table, index);
+        new_table.count++;
+    }
 
-    const u64 size_in_bytes = new_table.capacity * (sizeof(State) + sizeof(Hash) + sizeof(KeyType) + sizeof(ValueType));
-    void* allocation = platform_allocate(size_in_bytes);
-    gn_assert_with_message(allocation, "Could not allocate data for resizing hash table!");
+    hash_table_free_allocation(table);
+    table = new_table;
+}
 
-    new_table.states = (State*)     (allocation);
-    new_table.hashes = (Hash*)      (new_table.states + new_table.capacity);
-    new_table.keys   = (KeyType*)   (new_table.hashes + new_table.capacity);
-    new_table.values = (ValueType*) (new_table.keys   + new_table.capacity);
+// Clears all tombstones without reallocating
+HASH_TABLE_TEMPLATE
+void rehash(HashTable<KeyType, ValueType, Hasher>& table)
+{
+    using HashTable = HashTable<KeyType, ValueType, Hasher>;
 
-    platform_set_memory(new_table.states, (int) State::EMPTY, new_table.capacity * sizeof(State));
+    // Tombstones become empty slots and alive slots get marked as tombstones
+    // which means they still need to be placed at their new position
+    for (u32 i = 0; i < table.capacity; i++)
+        table.controls[i] = (table.controls[i] >= 0) ? HashTable::TOMBSTONE : HashTable::EMPTY;
 
-    u32 elements_to_copy = table.filled;
-    for (u32 old_index = 0; elements_to_copy > 0 && old_index < table.capacity; old_index++)
+    for (u32 i = 0; i < table.capacity; i++)
     {
-        if (table.states[old_index] != State::ALIVE)
+        if (table.controls[i] != HashTable::TOMBSTONE)
             continue;
 
-        // Need to copy element
-        elements_to_copy--;
+        const Hash hash = table.hasher(table.keys[i]);
+        const u32 new_index = hash_table_find_free_slot(table, hash);
 
-        const Hash hash = table.hashes[old_index];
-        const u32 end_index   = hash % new_table.capacity;
-        const u32 start_index = (end_index + 1) % new_table.capacity;
-
-        for (u32 i = start_index; i != end_index; i = (i + 1) % new_table.capacity)
+        // Already in the first group with a free slot in its probe sequence
+        if (new_index / HASH_TABLE_GROUP_SIZE == i / HASH_TABLE_GROUP_SIZE)
         {
-            if (new_table.states[i] == State::EMPTY)
-            {
-                new_table.states[i] = State::ALIVE;
-                new_table.hashes[i] = hash;
-                new_table.keys[i]   = table.keys[old_index];
-                new_table.values[i] = table.values[old_index];
+            table.controls[i] = hash_table_h2(hash);
+            continue;
+        }
 
-                break;
-            }
+        if (table.controls[new_index] == HashTable::EMPTY)
+        {
+            table.controls[new_index] = hash_table_h2(hash);
+            table.keys[new_index]     = table.keys[i];
+            table.values[new_index]   = table.values[i];
+            table.controls[i] = HashTable::EMPTY;
+        }
+        else
+        {
+            // Target still has an element that needs placing, swap and process this slot again
+            table.controls[new_index] = hash_table_h2(hash);
+            swap(table.keys[new_index], table.keys[i]);
+            swap(table.values[new_index], table.values[i]);
+            i--;
         }
     }
 
-    gn_assert_with_message(elements_to_copy == 0, "Not all elements were copied when resizing hash table! (elements left to copy: %)", elements_to_copy);
+    // Elements moved around too much to keep track of bit by bit
+    hash_table_rebuild_occupied(table);
+    table.tombstones = 0;
+}
 
-    free(table.states);
-    table = new_table;
+// Reallocates the table to the smallest capacity that fits all the elements
+HASH_TABLE_TEMPLATE
+void shrink_to_fit(HashTable<KeyType, ValueType, Hasher>& table)
+{
+    const u32 min_capacity = (u32) ((f32) table.count / HASH_TABLE_MAX_LOAD_FACTOR) + 1;
+    const u32 new_capacity = Math::next_power_of_2(max(min_capacity, (u32) HASH_TABLE_GROUP_SIZE));
+
+    if (new_capacity < table.capacity)
+        resize(table, new_capacity);
+    else if (table.tombstones > 0)
+        rehash(table);
 }
 
+// Hash must be the same as the one the table's hasher would give for the key
 HASH_TABLE_TEMPLATE
-HashTableElement<KeyType, ValueType, Hasher> find(const HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key)
+HashTableElement<KeyType, ValueType, Hasher> find_with_hash(const HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key, const Hash hash)
 {
     using HashTable        = HashTable<KeyType, ValueType, Hasher>;
     using HashTableElement = HashTableElement<KeyType, ValueType, Hasher>;
-    using State            = HashTable::State;
 
-    const Hash hash = table.hasher(key);
-    const u32 end_index   = hash % table.capacity;
-    const u32 start_index = (end_index + 1) % table.capacity;
+    const s8 h2 = hash_table_h2(hash);
+
+    const u32 group_mask = (table.capacity / HASH_TABLE_GROUP_SIZE) - 1;
+    u32 group = hash_table_h1(hash) & group_mask;
 
-    for (u32 i = start_index; i != end_index; i = (i + 1) % table.capacity)
+    for (u32 step = 1; step <= group_mask + 1; step++)
     {
-        switch (table.states[i])
+        const s8* group_controls = table.controls + group * HASH_TABLE_GROUP_SIZE;
+
+        u32 matches = hash_table_group_match(group_controls, h2);
+        while (matches)
         {
-            case State::EMPTY:
-                return HashTableElement { &table, table.capacity };
-            
-            case State::ALIVE:
-            {
-                if (hash == table.hashes[i] &&
-                    key  == table.keys[i])
-                {
-                    return HashTableElement { &table, i };
-                }
-            } break;
+            const u32 index = group * HASH_TABLE_GROUP_SIZE + GN_COUNT_TRAILING_ZEROS_32(matches);
+            if (key == table.keys[index])
+                return HashTableElement { &table, index };
+
+            matches &= matches - 1;
         }
+
+        // Key would have been placed in this group if it existed
+        if (hash_table_group_match(group_controls, HashTable::EMPTY))
+            return HashTableElement { &table, table.capacity };
+
+        group = (group + step) & group_mask;
     }
 
     gn_assert_with_message(false, "Reached end of hash table without finding an empty or valid element! (key: %)", key);
@@ -287,70 +495,172 @@ HashTableElement<KeyType, ValueType, Hasher> find(const HashTable<KeyType, Value
 }
 
 HASH_TABLE_TEMPLATE
-HashTableElement<KeyType, ValueType, Hasher> put(HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key, const ValueType& value)
+inline HashTableElement<KeyType, ValueType, Hasher> find(const HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key)
+{
+    return find_with_hash(table, key, table.hasher(key));
+}
+
+// Hash must be the same as the one the table's hasher would give for the key
+HASH_TABLE_TEMPLATE
+HashTableElement<KeyType, ValueType, Hasher> put_with_hash(HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key, const Hash hash, const ValueType& value)
 {
     using HashTable        = HashTable<KeyType, ValueType, Hasher>;
     using HashTableElement = HashTableElement<KeyType, ValueType, Hasher>;
-    using State            = HashTable::State;
 
-    const float load = (float) table.filled / (float) table.capacity;
-    if (load >= HASH_TABLE_MAX_LOAD_FACTOR)
-        resize(table, table.capacity * 2);
+    if ((f32) (table.count + table.tombstones + 1) > HASH_TABLE_MAX_LOAD_FACTOR * (f32) table.capacity)
+    {
+        // Get rid of tombstones instead of growing if they're taking up enough of the table
+        if ((f32) table.tombstones >= HASH_TABLE_MAX_TOMBSTONE_FACTOR * (f32) table.capacity)
+            rehash(table);
+        else
+            resize(table, table.capacity * 2);
+    }
+
+    const s8 h2 = hash_table_h2(hash);
+
+    const u32 group_mask = (table.capacity / HASH_TABLE_GROUP_SIZE) - 1;
+    u32 group = hash_table_h1(hash) & group_mask;
 
-    const Hash hash = table.hasher(key);
-    const u32 end_index   = hash % table.capacity;
-    const u32 start_index = (end_index + 1) % table.capacity;
+    // First tombstone or empty slot found along the probe sequence
+    u32 free_index = table.capacity;
 
-    for (u32 i = start_index; i != end_index; i = (i + 1) % table.capacity)
+    for (u32 step = 1; step <= group_mask + 1; step++)
     {
-        switch (table.states[i])
+        const s8* group_controls = table.controls + group * HASH_TABLE_GROUP_SIZE;
+
+        u32 matches = hash_table_group_match(group_controls, h2);
+        while (matches)
         {
-            case State::EMPTY:
-            case State::TOMBSTONE:
-            {
-                table.filled++;
+            const u32 index = group * HASH_TABLE_GROUP_SIZE + GN_COUNT_TRAILING_ZEROS_32(matches);
+            if (key == table.keys[index])
+                return HashTableElement { &table, index };
 
-                table.states[i] = State::ALIVE;
-                table.hashes[i] = hash;
-                table.keys[i]   = key;
-                table.values[i] = value;
-                return HashTableElement { &table, i };
-            }
-            
-            case State::ALIVE:
-            {
-                if (hash == table.hashes[i] &&
-                    key  == table.keys[i])
-                {
-                    return HashTableElement { &table, i };
-                }
-            } break;
+            matches &= matches - 1;
         }
+
+        const u32 free_slots = hash_table_group_match_free(group_controls);
+        if (free_slots && free_index == table.capacity)
+            free_index = group * HASH_TABLE_GROUP_SIZE + GN_COUNT_TRAILING_ZEROS_32(free_slots);
+
+        // Key can't be further along the probe sequence
+        if (hash_table_group_match(group_controls, HashTable::EMPTY))
+            break;
+
+        group = (group + step) & group_mask;
     }
 
-    // Never reached
-    gn_assert_with_message(false, "Ran out of entries in hash table to place element! (key: %)", key);
-    return HashTableElement { &table, table.capacity };
+    if (free_index == table.capacity)
+    {
+        // Never reached
+        gn_assert_with_message(false, "Ran out of entries in hash table to place element! (key: %)", key);
+        return HashTableElement { &table, table.capacity };
+    }
+
+    if (table.controls[free_index] == HashTable::TOMBSTONE)
+        table.tombstones--;
+
+    table.count++;
+
+    table.controls[free_index] = h2;
+    table.keys[free_index]     = key;
+    table.values[free_index]   = value;
+    hash_table_mark_alive(table, free_index);
+    return HashTableElement { &table, free_index };
+}
+
+HASH_TABLE_TEMPLATE
+inline HashTableElement<KeyType, ValueType, Hasher> put(HashTable<KeyType, ValueType, Hasher>& table, const KeyType& key, const ValueType& value)
+{
+    return put_with_hash(table, key, table.hasher(key), value);
 }
 
 HASH_TABLE_TEMPLATE
 inline void remove(HashTableElement<KeyType, ValueType, Hasher>& element)
 {
-    using HashTable        = HashTable<KeyType, ValueType, Hasher>;
-    using HashTableElement = HashTableElement<KeyType, ValueType, Hasher>;
-    using State            = HashTable::State;
+    using HashTable = HashTable<KeyType, ValueType, Hasher>;
 
-    const HashTable& table = *element.table;
+    HashTable& table = *const_cast<HashTable*>(element.table);
 
-    if (element.index >= table.capacity || table.states[element.index] != State::ALIVE)
+    if (element.index >= table.capacity || table.controls[element.index] < 0)
     {
         gn_assert_with_message(false, "Trying to delete a non existing element in hash table! (table index: %)", element.index);
         return;
     }
-    
-    table.states[element.index] = State::TOMBSTONE;
+
+    // If the group still has an empty slot, no probe sequence ever went past it.
+    // So the slot can be marked empty instead of leaving a tombstone behind.
+    const u32 group_start = element.index & ~(HASH_TABLE_GROUP_SIZE - 1);
+    if (hash_table_group_match(table.controls + group_start, HashTable::EMPTY))
+    {
+        table.controls[element.index] = HashTable::EMPTY;
+    }
+    else
+    {
+        table.controls[element.index] = HashTable::TOMBSTONE;
+        table.tombstones++;
+    }
+
+    hash_table_mark_free(table, element.index);
+    table.count--;
+
     element.index = table.capacity;
 }
 
+struct HashTableStats
+{
+    u32 count;
+    u32 tombstones;
+    u32 capacity;
+    f32 load_factor;            // Includes tombstones
+
+    // Number of groups probed to find an element (1 means it was in its first group)
+    f32 average_probe_length;
+    u32 max_probe_length;
+};
+
+// Walks the whole table so don't call it every frame
+HASH_TABLE_TEMPLATE
+HashTableStats stats(const HashTable<KeyType, ValueType, Hasher>& table)
+{
+    HashTableStats result = {};
+    result.count       = table.count;
+    result.tombstones  = table.tombstones;
+    result.capacity    = table.capacity;
+    result.load_factor = (f32) (table.count + table.tombstones) / (f32) table.capacity;
+
+    const u32 group_mask = (table.capacity / HASH_TABLE_GROUP_SIZE) - 1;
+    u64 total_probe_length = 0;
+
+    for (auto elem : table)
+    {
+        const Hash hash = table.hasher(elem.key());
+        const u32 target_group = elem.index / HASH_TABLE_GROUP_SIZE;
+
+        u32 group = hash_table_h1(hash) & group_mask;
+        u32 probe_length = 1;
+
+        while (group != target_group)
+        {
+            group = (group + probe_length) & group_mask;
+            probe_length++;
+        }
+
+        total_probe_length += probe_length;
+        result.max_probe_length = max(result.max_probe_length, probe_length);
+    }
+
+    u64 occupied_count = 0;
+    for (u32 i = 0; i < hash_table_occupied_word_count(table.capacity); i++)
+        occupied_count += GN_POPULATION_COUNT_64(table.occupied[i]);
+
+    gn_assert_with_message(occupied_count == table.count, "Hash table bitmask is out of sync with its elements! (bits set: %, count: %)", occupied_count, table.count);
+
+    result.average_probe_length = (table.count > 0) ? (f32) total_probe_length / (f32) table.count : 0.0f;
+
+    return result;
+}
+
+#undef HASH_TABLE_GROUP_SIZE
+#undef HASH_TABLE_MAX_TOMBSTONE_FACTOR
 #undef HASH_TABLE_MAX_LOAD_FACTOR
-#undef HASH_TABLE_TEMPLATE
\ No newline at end of file
+#undef HASH_TABLE_TEMPLATE
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "core/allocator.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Bounded lock-free ring buffers for passing work between threads.
+// Capacity has to be a power of 2 so positions wrap with a mask, and
+// the positions written by each side sit on their own cache line.
+// Elements are copied around with memcpy so they have to be trivially copyable.
+// Queues can't be copied (they're shared between threads), so they have
+// to be made in place: SpscQueue<Job> jobs = make<SpscQueue<Job>>(256ull);
+
+#define QUEUE_CACHE_LINE_SIZE 64
+
+static inline bool queue_is_power_of_2(u64 value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// Single producer, single consumer
+
+template <typename T>
+struct SpscQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Queue elements have to be trivially copyable!");
+
+    T*  data;
+    u64 mask;
+
+    Allocator* allocator;
+
+    // Written by the producer
+    alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<u64> tail;
+    u64 cached_head;    // Producer only rereads head when this says the queue is full
+
+    // Written by the consumer
+    alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<u64> head;
+    u64 cached_tail;    // Consumer only rereads tail when this says the queue is empty
+};
+
+template <typename T>
+inline SpscQueue<T> make(Type<SpscQueue<T>>, u64 capacity, Allocator* allocator = nullptr)
+{
+    gn_assert_with_message(queue_is_power_of_2(capacity), "Queue capacity has to be a power of 2! (capacity: %)", capacity);
+
+    T* data = (T*) allocator_allocate(allocator, capacity * sizeof(T), alignof(T));
+    gn_assert_with_message(data, "Could not allocate data for queue!");
+
+    return SpscQueue<T> { data, capacity - 1, allocator, { 0 }, 0, { 0 }, 0 };
+}
+
+// Neither side can be using the queue anymore
+template <typename T>
+inline void free(SpscQueue<T>& queue)
+{
+    allocator_free(queue.allocator, queue.data, (queue.mask + 1) * sizeof(T), alignof(T));
+
+    queue.data = nullptr;
+    queue.mask = 0;
+}
+
+// Copies a range of positions in or out of the ring, wrapping around the end if needed
+template <typename T>
+static inline void queue_copy_to_ring(T* ring, u64 mask, u64 position, const T* items, u64 count)
+{
+    const u64 start = position & mask;
+    const u64 first = min(count, mask + 1 - start);
+
+    platform_copy_memory(ring + start, items, first * sizeof(T));
+    platform_copy_memory(ring, items + first, (count - first) * sizeof(T));
+}
+
+template <typename T>
+static inline void queue_copy_from_ring(T* items, const T* ring, u64 mask, u64 position, u64 count)
+{
+    const u64 start = position & mask;
+    const u64 first = min(count, mask + 1 - start);
+
+    platform_copy_memory(items, ring + start, first * sizeof(T));
+    platform_copy_memory(items + first, ring, (count - first) * sizeof(T));
+}
+
+// Producer only. Pushes as many items as fit and returns how many that was.
+template <typename T>
+inline u64 push_n(SpscQueue<T>& queue, const T* items, u64 count)
+{
+    const u64 tail = queue.tail.load(std::memory_order_relaxed);
+    const u64 capacity = queue.mask + 1;
+
+    if (tail + count - queue.cached_head > capacity)
+        queue.cached_head = queue.head.load(std::memory_order_acquire);
+
+    count = min(count, capacity - (tail - queue.cached_head));
+    if (count == 0)
+        return 0;
+
+    queue_copy_to_ring(queue.data, queue.mask, tail, items, count);
+    queue.tail.store(tail + count, std::memory_order_release);
+
+    return count;
+}
+
+// Producer only. Returns false if the queue is full.
+template <typename T>
+inline bool push(SpscQueue<T>& queue, const T& item)
+{
+    return push_n(queue, &item, 1) == 1;
+}
+
+// Consumer only. Pops up to max_count items and returns how many were popped.
+template <typename T>
+inline u64 pop_n(SpscQueue<T>& queue, T* out_items, u64 max_count)
+{
+    const u64 head = queue.head.load(std::memory_order_relaxed);
+
+    if (queue.cached_tail - head < max_count)
+        queue.cached_tail = queue.tail.load(std::memory_order_acquire);
+
+    const u64 count = min(max_count, queue.cached_tail - head);
+    if (count == 0)
+        return 0;
+
+    queue_copy_from_ring(out_items, queue.data, queue.mask, head, count);
+    queue.head.store(head + count, std::memory_order_release);
+
+    return count;
+}
+
+// Consumer only. Returns false if the queue is empty.
+template <typename T>
+inline bool pop(SpscQueue<T>& queue, T& out_item)
+{
+    return pop_n(queue, &out_item, 1) == 1;
+}
+
+// Only a snapshot, the other side can change it right after
+template <typename T>
+inline u64 approximate_size(const SpscQueue<T>& queue)
+{
+    return queue.tail.load(std::memory_order_acquire) - queue.head.load(std::memory_order_acquire);
+}
+
+// Multiple producers, multiple consumers
+// Every cell has a sequence number that says which lap of the ring it's ready for,
+// so producers and consumers only ever contend on the position they're claiming.
+
+template <typename T>
+struct MpmcQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Queue elements have to be trivially copyable!");
+
+    struct Cell
+    {
+        std::atomic<u64> sequence;
+        T value;
+    };
+
+    Cell* cells;
+    u64   mask;
+
+    Allocator* allocator;
+
+    alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<u64> enqueue_position;
+    alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<u64> dequeue_position;
+};
+
+template <typename T>
+inline MpmcQueue<T> make(Type<MpmcQueue<T>>, u64 capacity, Allocator* allocator = nullptr)
+{
+    using Cell = typename MpmcQueue<T>::Cell;
+
+    gn_assert_with_message(queue_is_power_of_2(capacity), "Queue capacity has to be a power of 2! (capacity: %)", capacity);
+
+    Cell* cells = (Cell*) allocator_allocate(allocator, capacity * sizeof(Cell), alignof(Cell));
+    gn_assert_with_message(cells, "Could not allocate data for queue!");
+
+    // Cell i is ready to be written at position i
+    for (u64 i = 0; i < capacity; i++)
+        new (&cells[i].sequence) std::atomic<u64>(i);
+
+    return MpmcQueue<T> { cells, capacity - 1, allocator, { 0 }, { 0 } };
+}
+
+// No thread can be using the queue anymore
+template <typename T>
+inline void free(MpmcQueue<T>& queue)
+{
+    allocator_free(queue.allocator, queue.cells, (queue.mask + 1) * sizeof(typename MpmcQueue<T>::Cell), alignof(typename MpmcQueue<T>::Cell));
+
+    queue.cells = nullptr;
+    queue.mask = 0;
+}
+
+// Pushes as many items as fit (in one contiguous claim) and returns how many that was
+template <typename T>
+inline u64 push_n(MpmcQueue<T>& queue, const T* items, u64 count)
+{
+    if (count == 0)
+        return 0;
+
+    u64 position = queue.enqueue_position.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        // Count the cells from position on that are free for this lap
+        u64 available = 0;
+        while (available < count)
+        {
+            const u64 sequence = queue.cells[(position + available) & queue.mask].sequence.load(std::memory_order_acquire);
+            if (sequence != position + available)
+                break;
+
+            available++;
+        }
+
+        if (available == 0)
+        {
+            const u64 sequence = queue.cells[position & queue.mask].sequence.load(std::memory_order_acquire);
+
+            // Consumers haven't freed the cell yet so the queue is full
+            if ((s64) (sequence - position) < 0)
+                return 0;
+
+            // Another producer got here first
+            position = queue.enqueue_position.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (queue.enqueue_position.compare_exchange_weak(position, position + available, std::memory_order_relaxed))
+        {
+            for (u64 i = 0; i < available; i++)
+            {
+                auto& cell = queue.cells[(position + i) & queue.mask];
+                cell.value = items[i];
+                cell.sequence.store(position + i + 1, std::memory_order_release);
+            }
+
+            return available;
+        }
+
+        // Failed exchange reloaded position, try again from there
+    }
+}
+
+// Returns false if the queue is full
+template <typename T>
+inline bool push(MpmcQueue<T>& queue, const T& item)
+{
+    return push_n(queue, &item, 1) == 1;
+}
+
+// Pops up to max_count items (in one contiguous claim) and returns how many were popped
+template <typename T>
+inline u64 pop_n(MpmcQueue<T>& queue, T* out_items, u64 max_count)
+{
+    if (max_count == 0)
+        return 0;
+
+    u64 position = queue.dequeue_position.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        // Count the cells from position on that producers have finished writing
+        u64 available = 0;
+        while (available < max_count)
+        {
+            const u64 sequence = queue.cells[(position + available) & queue.mask].sequence.load(std::memory_order_acquire);
+            if (sequence != position + available + 1)
+                break;
+
+            available++;
+        }
+
+        if (available == 0)
+        {
+            const u64 sequence = queue.cells[position & queue.mask].sequence.load(std::memory_order_acquire);
+
+            // Nothing has been written to the cell yet so the queue is empty
+            if ((s64) (sequence - (position + 1)) < 0)
+                return 0;
+
+            // Another consumer got here first
+            position = queue.dequeue_position.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (queue.dequeue_position.compare_exchange_weak(position, position + available, std::memory_order_relaxed))
+        {
+            for (u64 i = 0; i < available; i++)
+            {
+                auto& cell = queue.cells[(position + i) & queue.mask];
+                out_items[i] = cell.value;
+
+                // Free the cell for the next lap
+                cell.sequence.store(position + i + queue.mask + 1, std::memory_order_release);
+            }
+
+            return available;
+        }
+    }
+}
+
+// Returns false if the queue is empty
+template <typename T>
+inline bool pop(MpmcQueue<T>& queue, T& out_item)
+{
+    return pop_n(queue, &out_item, 1) == 1;
+}
+
+// Only a snapshot, other threads can change it right after
+template <typename T>
+inline u64 approximate_size(const MpmcQueue<T>& queue)
+{
+    const u64 enqueued = queue.enqueue_position.load(std::memory_order_acquire);
+    const u64 dequeued = queue.dequeue_position.load(std::memory_order_acquire);
+
+    return (enqueued > dequeued) ? enqueued - dequeued : 0;
+}
+
+#undef QUEUE_CACHE_LINE_SIZE
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "core/allocator.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Generational slot map. Inserting gives back a 32 bit handle (slot index
+// plus generation) that stays valid until that element is removed. Once it's
+// removed the slot's generation changes, so old handles stop resolving
+// instead of aliasing whatever gets put in the slot next.
+// Values are kept densely packed so they can be iterated over directly.
+
+#define SLOT_MAP_INDEX_BITS 20
+#define SLOT_MAP_INDEX_MASK ((1u << SLOT_MAP_INDEX_BITS) - 1)
+#define SLOT_MAP_MAX_GENERATION ((1u << (32 - SLOT_MAP_INDEX_BITS)) - 1)
+
+struct SlotHandle
+{
+    u32 value;      // Generation in the high bits, slot index in the low bits
+};
+
+// Generations start at 1 so a zeroed handle never points to anything
+constexpr SlotHandle SLOT_HANDLE_INVALID = SlotHandle { 0 };
+
+inline bool operator==(const SlotHandle a, const SlotHandle b)
+{
+    return a.value == b.value;
+}
+
+inline bool operator!=(const SlotHandle a, const SlotHandle b)
+{
+    return a.value != b.value;
+}
+
+template <typename T>
+struct SlotMap
+{
+    struct Slot
+    {
+        u32 index;          // Index into the dense arrays while alive, next free slot otherwise
+        u32 generation;
+    };
+
+    // Dense, only the first size elements are valid
+    T*   values;
+    u32* value_slots;       // Slot that owns each dense value
+
+    Slot* slots;
+    u32   slot_count;       // Slots that have been handed out at least once
+    u32   free_slot;        // Head of the free list, slot_count if it's empty
+
+    u32 size;
+    u32 capacity;
+
+    Allocator* allocator;
+
+    T* begin() { return values; }
+    T* end()   { return values + size; }
+
+    const T* begin() const { return values; }
+    const T* end()   const { return values + size; }
+};
+
+static inline u32 slot_handle_index(const SlotHandle handle)
+{
+    return handle.value & SLOT_MAP_INDEX_MASK;
+}
+
+static inline u32 slot_handle_generation(const SlotHandle handle)
+{
+    return handle.value >> SLOT_MAP_INDEX_BITS;
+}
+
+// Values come first so they get the allocation's alignment, slots are padded to their own
+template <typename T>
+static inline u64 slot_map_slots_offset(u32 capacity)
+{
+    using Slot = typename SlotMap<T>::Slot;
+    return ((u64) capacity * sizeof(T) + alignof(Slot) - 1) & ~((u64) alignof(Slot) - 1);
+}
+
+template <typename T>
+static inline u64 slot_map_allocation_size(u32 capacity)
+{
+    using Slot = typename SlotMap<T>::Slot;
+    return slot_map_slots_offset<T>(capacity) + (u64) capacity * (sizeof(Slot) + sizeof(u32));
+}
+
+template <typename T>
+inline SlotMap<T> make(Type<SlotMap<T>>, u32 start_cap = 16, Allocator* allocator = nullptr)
+{
+    using Slot = typename SlotMap<T>::Slot;
+
+    SlotMap<T> map;
+
+    map.allocator  = allocator;
+    map.capacity   = max(start_cap, 1u);
+    map.size       = 0;
+    map.slot_count = 0;
+    map.free_slot  = 0;
+
+    u8* allocation = (u8*) allocator_allocate(map.allocator, slot_map_allocation_size<T>(map.capacity), alignof(T));
+    gn_assert_with_message(allocation, "Could not allocate data for slot map!");
+
+    map.values      = (T*)    (allocation);
+    map.slots       = (Slot*) (allocation + slot_map_slots_offset<T>(map.capacity));
+    map.value_slots = (u32*)  (map.slots  + map.capacity);
+
+    return map;
+}
+
+template <typename T>
+inline void free(SlotMap<T>& map)
+{
+    allocator_free(map.allocator, map.values, slot_map_allocation_size<T>(map.capacity), alignof(T));
+
+    map.values      = nullptr;
+    map.value_slots = nullptr;
+    map.slots       = nullptr;
+    map.size = map.capacity = map.slot_count = map.free_slot = 0;
+}
+
+template <typename T>
+inline void resize(SlotMap<T>& map, u32 new_capacity)
+{
+    gn_assert_with_message(new_capacity >= map.slot_count, "Slot map can't be resized to be smaller than its slot count! (new_capacity: %, slot count: %)", new_capacity, map.slot_count);
+    gn_assert_with_message(new_capacity <= SLOT_MAP_INDEX_MASK + 1, "Slot map can't have more slots than a handle can index! (new_capacity: %)", new_capacity);
+
+    SlotMap<T> new_map = make<SlotMap<T>>(new_capacity, map.allocator);
+
+    platform_copy_memory(new_map.values, map.values, map.size * sizeof(T));
+    platform_copy_memory(new_map.value_slots, map.value_slots, map.size * sizeof(u32));
+    platform_copy_memory(new_map.slots, map.slots, map.slot_count * sizeof(typename SlotMap<T>::Slot));
+
+    new_map.size       = map.size;
+    new_map.slot_count = map.slot_count;
+    new_map.free_slot  = map.free_slot;
+
+    free(map);
+    map = new_map;
+}
+
+template <typename T>
+inline SlotHandle insert(SlotMap<T>& map, const T& value)
+{
+    using Slot = typename SlotMap<T>::Slot;
+
+    u32 slot_index;
+
+    if (map.free_slot < map.slot_count)
+    {
+        slot_index = map.free_slot;
+        map.free_slot = map.slots[slot_index].index;
+    }
+    else
+    {
+        // Slots are only ever handed out when all the previous ones are alive
+        if (map.slot_count >= map.capacity)
+            resize(map, 2 * map.capacity);
+
+        slot_index = map.slot_count++;
+        map.slots[slot_index].generation = 1;
+
+        // Keep the free list terminated
+        map.free_slot = map.slot_count;
+    }
+
+    Slot& slot = map.slots[slot_index];
+    slot.index = map.size;
+
+    map.values[map.size]      = value;
+    map.value_slots[map.size] = slot_index;
+    map.size++;
+
+    return SlotHandle { (slot.generation << SLOT_MAP_INDEX_BITS) | slot_index };
+}
+
+// Returns nullptr if the element was removed or the handle is invalid
+template <typename T>
+inline T* find(const SlotMap<T>& map, const SlotHandle handle)
+{
+    const u32 slot_index = slot_handle_index(handle);
+    if (slot_index >= map.slot_count)
+        return nullptr;
+
+    const auto& slot = map.slots[slot_index];
+    if (slot.generation != slot_handle_generation(handle))
+        return nullptr;
+
+    return map.values + slot.index;
+}
+
+template <typename T>
+inline bool contains(const SlotMap<T>& map, const SlotHandle handle)
+{
+    return find(map, handle) != nullptr;
+}
+
+// Handle of the element at the given position in the dense array
+template <typename T>
+inline SlotHandle handle_at(const SlotMap<T>& map, u32 dense_index)
+{
+    gn_assert_with_message(dense_index < map.size, "Index out of bounds! (index: %, slot map size: %)", dense_index, map.size);
+
+    const u32 slot_index = map.value_slots[dense_index];
+    return SlotHandle { (map.slots[slot_index].generation << SLOT_MAP_INDEX_BITS) | slot_index };
+}
+
+// Last dense value fills the hole so iteration order isn't kept. Returns false if the handle was stale.
+template <typename T>
+inline bool remove(SlotMap<T>& map, const SlotHandle handle)
+{
+    T* value = find(map, handle);
+    if (!value)
+        return false;
+
+    const u32 slot_index  = slot_handle_index(handle);
+    const u32 dense_index = map.slots[slot_index].index;
+
+    {   // Move the last value into the hole
+        const u32 last_index = map.size - 1;
+
+        map.values[dense_index]      = map.values[last_index];
+        map.value_slots[dense_index] = map.value_slots[last_index];
+        map.slots[map.value_slots[dense_index]].index = dense_index;
+
+        map.size--;
+    }
+
+    {   // Retire the slot, generations wrap around but skip 0
+        auto& slot = map.slots[slot_index];
+        slot.generation = (slot.generation == SLOT_MAP_MAX_GENERATION) ? 1 : slot.generation + 1;
+
+        slot.index = map.free_slot;
+        map.free_slot = slot_index;
+    }
+
+    return true;
+}
+
+template <typename T>
+inline void clear(SlotMap<T>& map)
+{
+    // Every handed out handle has to go stale
+    while (map.size > 0)
+        remove(map, handle_at(map, map.size - 1));
+}
+
+#undef SLOT_MAP_INDEX_BITS
+#undef SLOT_MAP_INDEX_MASK
+#undef SLOT_MAP_MAX_GENERATION
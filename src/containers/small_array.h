@@ -0,0 +1,217 @@
+#pragma once
+
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Array that keeps up to N elements inline and only moves
+// to the heap once it grows past that. Meant for short lists
+// that usually have a handful of elements in them.
+
+template <typename T, u64 N>
+struct SmallArray
+{
+    T*  heap_data;      // nullptr while the elements fit inline
+    u64 size;
+    u64 capacity;
+    T   inline_data[N];
+
+    T* data()
+    {
+        return heap_data ? heap_data : inline_data;
+    }
+
+    const T* data() const
+    {
+        return heap_data ? heap_data : inline_data;
+    }
+
+    T& operator[](const u64 index)
+    {
+        gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %)", index, size);
+        return data()[index];
+    }
+
+    const T& operator[](const u64 index) const
+    {
+        gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %)", index, size);
+        return data()[index];
+    }
+
+    T* begin() { return data(); }
+    T* end()   { return data() + size; }
+
+    const T* begin() const { return data(); }
+    const T* end()   const { return data() + size; }
+};
+
+template <typename T, u64 N>
+inline SmallArray<T, N> make(Type<SmallArray<T, N>>)
+{
+    SmallArray<T, N> arr;
+
+    arr.heap_data = nullptr;
+    arr.size = 0;
+    arr.capacity = N;
+
+    return arr;
+}
+
+template <typename T, u64 N>
+inline SmallArray<T, N> copy(const SmallArray<T, N>& other)
+{
+    SmallArray<T, N> arr = make<SmallArray<T, N>>();
+
+    if (other.size > N)
+    {
+        arr.capacity = other.capacity;
+        arr.heap_data = (T*) platform_allocate(arr.capacity * sizeof(T));
+        gn_assert_with_message(arr.heap_data, "Could not allocate data for array!");
+    }
+
+    arr.size = other.size;
+
+    T* data = arr.data();
+    for (u64 i = 0; i < arr.size; i++)
+        data[i] = copy(other.data()[i]);
+
+    return arr;
+}
+
+template <typename T, u64 N>
+inline void free(SmallArray<T, N>& arr)
+{
+    if (arr.heap_data)
+        platform_free(arr.heap_data);
+
+    arr.heap_data = nullptr;
+    arr.size = 0;
+    arr.capacity = N;
+}
+
+template <typename T, u64 N>
+inline void free_all(SmallArray<T, N>& arr)
+{
+    for (u64 i = 0; i < arr.size; i++)
+        free(arr[i]);
+
+    free(arr);
+}
+
+template <typename T, u64 N>
+inline void clear(SmallArray<T, N>& arr)
+{
+    arr.size = 0;
+}
+
+template <typename T, u64 N>
+inline void clear_with_free(SmallArray<T, N>& arr)
+{
+    for (u64 i = 0; i < arr.size; i++)
+        free(arr[i]);
+
+    arr.size = 0;
+}
+
+// Only ever grows, elements don't move back inline once they're on the heap
+template <typename T, u64 N>
+inline void reserve(SmallArray<T, N>& arr, u64 new_capacity)
+{
+    if (new_capacity <= arr.capacity)
+        return;
+
+    if (arr.heap_data)
+    {
+        T* new_data = (T*) platform_reallocate(arr.heap_data, new_capacity * sizeof(T));
+        gn_assert_with_message(new_data, "Could not reallocate data for array!");
+
+        arr.heap_data = new_data;
+    }
+    else
+    {
+        T* new_data = (T*) platform_allocate(new_capacity * sizeof(T));
+        gn_assert_with_message(new_data, "Could not allocate data for array!");
+
+        platform_copy_memory(new_data, arr.inline_data, arr.size * sizeof(T));
+        arr.heap_data = new_data;
+    }
+
+    arr.capacity = new_capacity;
+}
+
+template <typename T, u64 N>
+inline SmallArray<T, N>& append(SmallArray<T, N>& arr, const T& elem)
+{
+    if (arr.size >= arr.capacity)
+        reserve(arr, 2 * arr.capacity);
+
+    arr.data()[arr.size++] = elem;
+    return arr;
+}
+
+template <typename T, u64 N>
+inline SmallArray<T, N>& append_many(SmallArray<T, N>& arr, const T* elems, u64 count)
+{
+    if (arr.size + count > arr.capacity)
+        reserve(arr, max(2 * arr.capacity, arr.size + count));
+
+    platform_copy_memory(arr.data() + arr.size, elems, count * sizeof(T));
+    arr.size += count;
+
+    return arr;
+}
+
+template <typename T, u64 N>
+inline T pop(SmallArray<T, N>& arr)
+{
+    gn_assert_with_message(arr.size > 0, "Trying to pop elements from an array that has 0 elements!");
+    return arr.data()[--arr.size];
+}
+
+template <typename T, u64 N>
+inline T remove(SmallArray<T, N>& arr, u64 index)
+{
+    gn_assert_with_message(arr.size > 0, "Trying to remove elements from an array that has 0 elements!");
+    gn_assert_with_message(index < arr.size,  "Trying to remove from an out of bounds index! (index: %, array size: %)", index, arr.size);
+
+    T* data = arr.data();
+    T removed = data[index];
+
+    // Move all values back by 1 index
+    for (u64 i = index; i < arr.size - 1; i++)
+        data[i] = data[i + 1];
+
+    arr.size--;
+
+    return removed;
+}
+
+template <typename T, u64 N>
+inline T remove_swap(SmallArray<T, N>& arr, u64 index)
+{
+    gn_assert_with_message(arr.size > 0, "Trying to remove elements from an array that has 0 elements!");
+    gn_assert_with_message(index < arr.size,  "Trying to remove from an out of bounds index! (index: %, array size: %)", index, arr.size);
+
+    T* data = arr.data();
+    T removed = data[index];
+
+    arr.size--;
+    data[index] = data[arr.size];
+
+    return removed;
+}
+
+template <typename T, u64 N>
+inline u64 find(const SmallArray<T, N>& arr, const T& needle)
+{
+    const T* data = arr.data();
+    for (u64 i = 0; i < arr.size; i++)
+    {
+        if (data[i] == needle)
+            return i;
+    }
+
+    return arr.size;
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "core/allocator.h"
+#include "math/common.h"
+#include "platform/platform.h"
+#include "darray.h"
+
+// Structure of arrays table. Every column is stored contiguously (all of them
+// share one allocation) so loops that only need one column don't drag the
+// others through the cache. Rows are added, removed and moved across all
+// columns at once. Columns are expected to be trivially copyable.
+
+#define SOA_TABLE_COLUMN_ALIGNMENT 16     // Minimum, columns of over-aligned types get their own alignment
+
+template <u64 Index, typename... Columns>
+struct SoAColumnType;
+
+template <typename First, typename... Rest>
+struct SoAColumnType<0, First, Rest...>
+{
+    using Type = First;
+};
+
+template <u64 Index, typename First, typename... Rest>
+struct SoAColumnType<Index, First, Rest...>
+{
+    using Type = typename SoAColumnType<Index - 1, Rest...>::Type;
+};
+
+template <typename... Columns>
+struct SoATable
+{
+    static constexpr u64 column_count = sizeof...(Columns);
+
+    void* columns[column_count];
+    u64   size;
+    u64   capacity;
+
+    Allocator* allocator;
+};
+
+// Index can be any integer or enum value
+template <auto Index, typename... Columns>
+inline typename SoAColumnType<(u64) Index, Columns...>::Type* column(SoATable<Columns...>& table)
+{
+    static_assert((u64) Index < sizeof...(Columns), "Column index out of bounds!");
+    return (typename SoAColumnType<(u64) Index, Columns...>::Type*) table.columns[(u64) Index];
+}
+
+template <auto Index, typename... Columns>
+inline const typename SoAColumnType<(u64) Index, Columns...>::Type* column(const SoATable<Columns...>& table)
+{
+    static_assert((u64) Index < sizeof...(Columns), "Column index out of bounds!");
+    return (const typename SoAColumnType<(u64) Index, Columns...>::Type*) table.columns[(u64) Index];
+}
+
+// Calls func with a typed pointer to each column in order
+template <typename... Columns, typename Func>
+inline void soa_table_for_each_column(SoATable<Columns...>& table, Func func)
+{
+    u64 index = 0;
+    (func((Columns*) table.columns[index++]), ...);
+}
+
+template <typename T>
+static constexpr u64 soa_table_column_alignment()
+{
+    return max((u64) alignof(T), (u64) SOA_TABLE_COLUMN_ALIGNMENT);
+}
+
+// The whole allocation has to be aligned for the most aligned column
+template <typename... Columns>
+static constexpr u64 soa_table_allocation_alignment()
+{
+    u64 alignment = SOA_TABLE_COLUMN_ALIGNMENT;
+    ((alignment = max(alignment, soa_table_column_alignment<Columns>())), ...);
+    return alignment;
+}
+
+static inline u64 soa_table_align_offset(u64 offset, u64 alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+template <typename... Columns>
+static inline u64 soa_table_allocation_size(u64 capacity)
+{
+    u64 size = 0;
+    ((size = soa_table_align_offset(size, soa_table_column_alignment<Columns>()) + capacity * sizeof(Columns)), ...);
+    return size;
+}
+
+// Uses the allocator that's already set on the table, doesn't touch size
+template <typename... Columns>
+static inline void soa_table_allocate(SoATable<Columns...>& table, u64 capacity)
+{
+    table.capacity = capacity;
+
+    u8* allocation = (u8*) allocator_allocate(table.allocator, soa_table_allocation_size<Columns...>(capacity), soa_table_allocation_alignment<Columns...>());
+    gn_assert_with_message(allocation, "Could not allocate data for SoA table!");
+
+    u64 offset = 0;
+    u64 index = 0;
+    ((offset = soa_table_align_offset(offset, soa_table_column_alignment<Columns>()),
+      table.columns[index++] = allocation + offset,
+      offset += capacity * sizeof(Columns)), ...);
+}
+
+template <typename... Columns>
+inline SoATable<Columns...> make(Type<SoATable<Columns...>>, u64 start_cap = 16, Allocator* allocator = nullptr)
+{
+    SoATable<Columns...> table;
+
+    table.allocator = allocator;
+    table.size = 0;
+    soa_table_allocate(table, start_cap);
+
+    return table;
+}
+
+template <typename... Columns>
+inline void free(SoATable<Columns...>& table)
+{
+    // Columns are all part of the first column's allocation
+    allocator_free(table.allocator, table.columns[0], soa_table_allocation_size<Columns...>(table.capacity), soa_table_allocation_alignment<Columns...>());
+
+    for (u64 i = 0; i < table.column_count; i++)
+        table.columns[i] = nullptr;
+
+    table.size = table.capacity = 0;
+}
+
+template <typename... Columns>
+inline void clear(SoATable<Columns...>& table)
+{
+    table.size = 0;
+}
+
+template <typename... Columns>
+inline void resize(SoATable<Columns...>& table, u64 new_capacity)
+{
+    gn_assert_with_message(new_capacity >= table.size, "SoA table can't be resized to be smaller than its row count! (new_capacity: %, row count: %)", new_capacity, table.size);
+
+    SoATable<Columns...> new_table;
+    new_table.allocator = table.allocator;
+    new_table.size = table.size;
+    soa_table_allocate(new_table, new_capacity);
+
+    // Columns move to different offsets so they can't just be reallocated
+    constexpr u64 column_sizes[] = { sizeof(Columns)... };
+    for (u64 i = 0; i < table.column_count; i++)
+        platform_copy_memory(new_table.columns[i], table.columns[i], table.size * column_sizes[i]);
+
+    free(table);
+    table = new_table;
+}
+
+// Returns the index of the new row
+template <typename... Columns>
+inline u64 append(SoATable<Columns...>& table, const Columns&... values)
+{
+    if (table.size >= table.capacity)
+        resize(table, max(2 * table.capacity, 16ull));
+
+    const u64 row = table.size++;
+
+    u64 index = 0;
+    ((((Columns*) table.columns[index++])[row] = values), ...);
+
+    return row;
+}
+
+// Keeps the order of the rows after it
+template <typename... Columns>
+inline void remove(SoATable<Columns...>& table, u64 row)
+{
+    gn_assert_with_message(row < table.size, "Trying to remove from an out of bounds row! (row: %, row count: %)", row, table.size);
+
+    soa_table_for_each_column(table, [&](auto* column)
+    {
+        platform_move_memory(column + row, column + row + 1, (table.size - row - 1) * sizeof(*column));
+    });
+
+    table.size--;
+}
+
+// Last row is moved into the removed row's place
+template <typename... Columns>
+inline void remove_swap(SoATable<Columns...>& table, u64 row)
+{
+    gn_assert_with_message(row < table.size, "Trying to remove from an out of bounds row! (row: %, row count: %)", row, table.size);
+
+    table.size--;
+
+    soa_table_for_each_column(table, [&](auto* column)
+    {
+        column[row] = column[table.size];
+    });
+}
+
+template <typename T>
+static inline u64 soa_table_remove_rows_in_column(T* column, u64 size, const u64* sorted_rows, u64 count)
+{
+    // View over the column, it doesn't own anything
+    DynamicArray<T> view = { column, size, size, nullptr };
+    remove_indices(view, sorted_rows, count);
+
+    return view.size;
+}
+
+// Rows have to be sorted in ascending order, same as remove_indices for DynamicArray
+template <typename... Columns>
+inline void remove_rows(SoATable<Columns...>& table, const u64* sorted_rows, u64 count)
+{
+    u64 new_size = table.size;
+
+    soa_table_for_each_column(table, [&](auto* column)
+    {
+        new_size = soa_table_remove_rows_in_column(column, table.size, sorted_rows, count);
+    });
+
+    table.size = new_size;
+}
+
+template <typename... Columns>
+inline void swap_rows(SoATable<Columns...>& table, u64 row_a, u64 row_b)
+{
+    gn_assert_with_message(row_a < table.size && row_b < table.size, "Trying to swap an out of bounds row! (rows: % and %, row count: %)", row_a, row_b, table.size);
+
+    soa_table_for_each_column(table, [&](auto* column)
+    {
+        swap(column[row_a], column[row_b]);
+    });
+}
+
+// Moves the row to the end and shifts the ones after it back by 1
+template <typename... Columns>
+inline void move_to_back(SoATable<Columns...>& table, u64 row)
+{
+    gn_assert_with_message(row < table.size, "Trying to move an out of bounds row! (row: %, row count: %)", row, table.size);
+
+    soa_table_for_each_column(table, [&](auto* column)
+    {
+        auto moved = column[row];
+        platform_move_memory(column + row, column + row + 1, (table.size - row - 1) * sizeof(*column));
+        column[table.size - 1] = moved;
+    });
+}
+
+#undef SOA_TABLE_COLUMN_ALIGNMENT
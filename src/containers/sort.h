@@ -0,0 +1,557 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <emmintrin.h>
+#include "core/types.h"
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/allocator.h"
+#include "math/common.h"
+#include "platform/platform.h"
+#include "darray.h"
+
+// sort is a pattern-defeating quicksort: quicksort with a median of 3 (or
+// ninther) pivot that falls back to insertion sort for small ranges, notices
+// ranges that are already sorted, groups runs of equal elements and switches
+// to heapsort when partitions keep coming out unbalanced. It isn't stable.
+// radix_sort is a stable LSD radix sort on unsigned 32 or 64 bit keys. It
+// needs a second buffer as big as the array and splits the counting and
+// scatter passes across threads once there are enough elements. The threads
+// are started once per sort and wait on each other between passes.
+
+#define SORT_INSERTION_SORT_THRESHOLD     24
+#define SORT_NINTHER_THRESHOLD            128
+#define SORT_PARTIAL_INSERTION_SORT_LIMIT 8
+
+#define RADIX_SORT_INSERTION_SORT_THRESHOLD 64
+#define RADIX_SORT_MIN_THREAD_CHUNK         (1 << 18)   // Smaller sorts aren't worth starting threads for
+#define RADIX_SORT_MAX_THREADS              16
+#define RADIX_SORT_DIGIT_COUNT              256
+
+template <typename T, typename Less>
+static inline void sort_insertion(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return;
+
+    for (T* current = begin + 1; current != end; current++)
+    {
+        T* sift = current;
+        T* sift_prev = current - 1;
+
+        if (less(*sift, *sift_prev))
+        {
+            T temp = *sift;
+
+            do { *sift-- = *sift_prev; }
+            while (sift != begin && less(temp, *--sift_prev));
+
+            *sift = temp;
+        }
+    }
+}
+
+// Element right before begin has to be smaller than or equal to everything in the range
+template <typename T, typename Less>
+static inline void sort_insertion_unguarded(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return;
+
+    for (T* current = begin + 1; current != end; current++)
+    {
+        T* sift = current;
+        T* sift_prev = current - 1;
+
+        if (less(*sift, *sift_prev))
+        {
+            T temp = *sift;
+
+            do { *sift-- = *sift_prev; }
+            while (less(temp, *--sift_prev));
+
+            *sift = temp;
+        }
+    }
+}
+
+// Gives up and returns false once it has moved elements more than a few times
+template <typename T, typename Less>
+static inline bool sort_insertion_partial(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return true;
+
+    u64 moves = 0;
+    for (T* current = begin + 1; current != end; current++)
+    {
+        T* sift = current;
+        T* sift_prev = current - 1;
+
+        if (less(*sift, *sift_prev))
+        {
+            T temp = *sift;
+
+            do { *sift-- = *sift_prev; }
+            while (sift != begin && less(temp, *--sift_prev));
+
+            *sift = temp;
+            moves += (u64) (current - sift);
+        }
+
+        if (moves > SORT_PARTIAL_INSERTION_SORT_LIMIT)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T, typename Less>
+static inline void sort_2(T* a, T* b, Less& less)
+{
+    if (less(*b, *a))
+        swap(*a, *b);
+}
+
+template <typename T, typename Less>
+static inline void sort_3(T* a, T* b, T* c, Less& less)
+{
+    sort_2(a, b, less);
+    sort_2(b, c, less);
+    sort_2(a, b, less);
+}
+
+template <typename T, typename Less>
+static inline void sort_heap_sift_down(T* data, s64 root, s64 size, Less& less)
+{
+    while (true)
+    {
+        s64 child = 2 * root + 1;
+        if (child >= size)
+            return;
+
+        if (child + 1 < size && less(data[child], data[child + 1]))
+            child++;
+
+        if (!less(data[root], data[child]))
+            return;
+
+        swap(data[root], data[child]);
+        root = child;
+    }
+}
+
+template <typename T, typename Less>
+static inline void sort_heap(T* begin, T* end, Less& less)
+{
+    const s64 size = end - begin;
+
+    for (s64 i = size / 2; i > 0; i--)
+        sort_heap_sift_down(begin, i - 1, size, less);
+
+    for (s64 i = size - 1; i > 0; i--)
+    {
+        swap(begin[0], begin[i]);
+        sort_heap_sift_down(begin, 0, i, less);
+    }
+}
+
+// Pivot is the first element. Puts everything smaller than the pivot to its left and
+// returns where the pivot ended up. Sets already_partitioned if nothing had to be swapped.
+template <typename T, typename Less>
+static inline T* sort_partition_right(T* begin, T* end, Less& less, bool& already_partitioned)
+{
+    T pivot = *begin;
+
+    T* first = begin;
+    T* last  = end;
+
+    // Median of 3 guarantees there is an element that isn't smaller than the pivot
+    while (less(*++first, pivot));
+
+    // Nothing was skipped so the search from the right needs a bounds check
+    if (first - 1 == begin)
+        while (first < last && !less(*--last, pivot));
+    else
+        while (!less(*--last, pivot));
+
+    already_partitioned = first >= last;
+
+    while (first < last)
+    {
+        swap(*first, *last);
+        while (less(*++first, pivot));
+        while (!less(*--last, pivot));
+    }
+
+    T* pivot_position = first - 1;
+    *begin = *pivot_position;
+    *pivot_position = pivot;
+
+    return pivot_position;
+}
+
+// Puts everything equal to the pivot to its left. Used when the pivot is equal to the
+// element before the range, which means all of those are already in their final place.
+template <typename T, typename Less>
+static inline T* sort_partition_left(T* begin, T* end, Less& less)
+{
+    T pivot = *begin;
+
+    T* first = begin;
+    T* last  = end;
+
+    while (less(pivot, *--last));
+
+    if (last + 1 == end)
+        while (first < last && !less(pivot, *++first));
+    else
+        while (!less(pivot, *++first));
+
+    while (first < last)
+    {
+        swap(*first, *last);
+        while (less(pivot, *--last));
+        while (!less(pivot, *++first));
+    }
+
+    T* pivot_position = last;
+    *begin = *pivot_position;
+    *pivot_position = pivot;
+
+    return pivot_position;
+}
+
+template <typename T, typename Less>
+static void sort_loop(T* begin, T* end, Less& less, u32 bad_partitions_allowed, bool leftmost)
+{
+    while (true)
+    {
+        const s64 size = end - begin;
+
+        if (size < SORT_INSERTION_SORT_THRESHOLD)
+        {
+            if (leftmost)
+                sort_insertion(begin, end, less);
+            else
+                sort_insertion_unguarded(begin, end, less);
+
+            return;
+        }
+
+        // Pivot ends up at begin
+        const s64 half = size / 2;
+        if (size > SORT_NINTHER_THRESHOLD)
+        {
+            sort_3(begin, begin + half, end - 1, less);
+            sort_3(begin + 1, begin + (half - 1), end - 2, less);
+            sort_3(begin + 2, begin + (half + 1), end - 3, less);
+            sort_3(begin + (half - 1), begin + half, begin + (half + 1), less);
+            swap(*begin, *(begin + half));
+        }
+        else
+        {
+            sort_3(begin + half, begin, end - 1, less);
+        }
+
+        // Element before the range is equal to the pivot, so skip over all the equal elements
+        if (!leftmost && !less(*(begin - 1), *begin))
+        {
+            begin = sort_partition_left(begin, end, less) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        T* pivot_position = sort_partition_right(begin, end, less, already_partitioned);
+
+        const s64 left_size  = pivot_position - begin;
+        const s64 right_size = end - (pivot_position + 1);
+
+        if (left_size < size / 8 || right_size < size / 8)
+        {
+            // Too many bad pivots, quicksort is going quadratic
+            if (--bad_partitions_allowed == 0)
+            {
+                sort_heap(begin, end, less);
+                return;
+            }
+
+            // Shuffle some elements around to break up whatever pattern caused it
+            if (left_size >= SORT_INSERTION_SORT_THRESHOLD)
+            {
+                swap(begin[0], begin[left_size / 4]);
+                swap(pivot_position[-1], pivot_position[-left_size / 4]);
+
+                if (left_size > SORT_NINTHER_THRESHOLD)
+                {
+                    swap(begin[1], begin[left_size / 4 + 1]);
+                    swap(begin[2], begin[left_size / 4 + 2]);
+                    swap(pivot_position[-2], pivot_position[-(left_size / 4 + 1)]);
+                    swap(pivot_position[-3], pivot_position[-(left_size / 4 + 2)]);
+                }
+            }
+
+            if (right_size >= SORT_INSERTION_SORT_THRESHOLD)
+            {
+                swap(pivot_position[1], pivot_position[1 + right_size / 4]);
+                swap(end[-1], end[-right_size / 4]);
+
+                if (right_size > SORT_NINTHER_THRESHOLD)
+                {
+                    swap(pivot_position[2], pivot_position[2 + right_size / 4]);
+                    swap(pivot_position[3], pivot_position[3 + right_size / 4]);
+                    swap(end[-2], end[-(1 + right_size / 4)]);
+                    swap(end[-3], end[-(2 + right_size / 4)]);
+                }
+            }
+        }
+        else if (already_partitioned && sort_insertion_partial(begin, pivot_position, less) && sort_insertion_partial(pivot_position + 1, end, less))
+        {
+            // Range was (close to) sorted already
+            return;
+        }
+
+        // Recurse into the left side and loop on the right one
+        sort_loop(begin, pivot_position, less, bad_partitions_allowed, leftmost);
+        begin = pivot_position + 1;
+        leftmost = false;
+    }
+}
+
+// less(a, b) returns true if a has to come before b
+template <typename T, typename Less>
+inline void sort(T* data, u64 count, Less less)
+{
+    if (count < 2)
+        return;
+
+    // Number of bad partitions allowed before falling back to heapsort
+    u32 log2_count = 0;
+    for (u64 i = count; i > 1; i >>= 1)
+        log2_count++;
+
+    sort_loop(data, data + count, less, log2_count, true);
+}
+
+template <typename T>
+inline void sort(T* data, u64 count)
+{
+    sort(data, count, [](const T& a, const T& b) { return a < b; });
+}
+
+template <typename T, typename Less>
+inline void sort(DynamicArray<T>& arr, Less less)
+{
+    sort(arr.data, arr.size, less);
+}
+
+template <typename T>
+inline void sort(DynamicArray<T>& arr)
+{
+    sort(arr.data, arr.size);
+}
+
+// Keys that sort the same way as the float they're made from, so floats (like depth) can be radix sorted
+inline u32 radix_sort_key(f32 number)
+{
+    u32 bits;
+    memcpy(&bits, &number, sizeof(bits));
+
+    // Negative numbers get all their bits flipped so bigger magnitudes come first
+    return bits ^ ((u32) ((s32) bits >> 31) | 0x80000000u);
+}
+
+inline u64 radix_sort_key(f64 number)
+{
+    u64 bits;
+    memcpy(&bits, &number, sizeof(bits));
+
+    return bits ^ ((u64) ((s64) bits >> 63) | 0x8000000000000000ull);
+}
+
+template <typename Work>
+struct RadixSortTask
+{
+    Work* work;
+    u32 thread_index;
+};
+
+template <typename Work>
+static void radix_sort_run_task(void* data)
+{
+    RadixSortTask<Work>& task = *(RadixSortTask<Work>*) data;
+    (*task.work)(task.thread_index);
+}
+
+// Threads wait here until all of them got here. Generation changes every time the barrier opens.
+struct RadixSortBarrier
+{
+    std::atomic<u32> arrived;
+    std::atomic<u32> generation;
+    u32 thread_count;
+};
+
+static inline void radix_sort_barrier_wait(RadixSortBarrier& barrier)
+{
+    if (barrier.thread_count == 1)
+        return;
+
+    const u32 generation = barrier.generation.load(std::memory_order_acquire);
+
+    // Last one in opens it for everyone
+    if (barrier.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == barrier.thread_count)
+    {
+        barrier.arrived.store(0, std::memory_order_relaxed);
+        barrier.generation.fetch_add(1, std::memory_order_release);
+        platform_wake_all(barrier.generation);
+        return;
+    }
+
+    // Passes on different threads finish close together, so spin for a bit before going to sleep
+    for (u32 i = 0; i < 1024; i++)
+    {
+        if (barrier.generation.load(std::memory_order_acquire) != generation)
+            return;
+
+        _mm_pause();
+    }
+
+    while (barrier.generation.load(std::memory_order_acquire) == generation)
+        platform_wait_on_address(barrier.generation, generation);
+}
+
+// Calls work(thread_index) on thread_count threads (including the calling one) and waits for all of them
+template <typename Work>
+static inline void radix_sort_run(u32 thread_count, Work& work)
+{
+    RadixSortTask<Work> tasks[RADIX_SORT_MAX_THREADS - 1];
+    PlatformThread threads[RADIX_SORT_MAX_THREADS - 1];
+
+    for (u32 i = 1; i < thread_count; i++)
+    {
+        tasks[i - 1] = RadixSortTask<Work> { &work, i };
+        threads[i - 1] = platform_thread_create(radix_sort_run_task<Work>, &tasks[i - 1], "Radix Sort");
+    }
+
+    work(0);
+
+    for (u32 i = 1; i < thread_count; i++)
+        platform_thread_join(threads[i - 1]);
+}
+
+// key_function(element) has to return an unsigned 32 or 64 bit integer. Equal keys keep their order.
+template <typename T, typename KeyFunction>
+void radix_sort(T* data, u64 count, KeyFunction key_function, Allocator* allocator = nullptr)
+{
+    using Key = std::decay_t<decltype(key_function(*data))>;
+
+    static_assert(std::is_unsigned_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8), "Radix sort keys have to be unsigned 32 or 64 bit integers!");
+    static_assert(std::is_trivially_copyable_v<T>, "Radix sorted elements have to be trivially copyable!");
+
+    if (count < RADIX_SORT_INSERTION_SORT_THRESHOLD)
+    {
+        // Insertion sort is stable too
+        auto less = [&key_function](const T& a, const T& b) { return key_function(a) < key_function(b); };
+        sort_insertion(data, data + count, less);
+        return;
+    }
+
+    const u32 thread_count = (u32) clamp(min((u64) platform_get_processor_count(), count / RADIX_SORT_MIN_THREAD_CHUNK), 1ull, (u64) RADIX_SORT_MAX_THREADS);
+    const u64 chunk_size = (count + thread_count - 1) / thread_count;
+
+    T* buffer = (T*) allocator_allocate(allocator, count * sizeof(T), alignof(T));
+    gn_assert_with_message(buffer, "Could not allocate buffer for radix sort! (count: %)", count);
+
+    // Each thread counts (and later scatters) its own chunk, which keeps the sort stable
+    using DigitOffsets = u64[RADIX_SORT_DIGIT_COUNT];
+    DigitOffsets* offsets = (DigitOffsets*) allocator_allocate(allocator, thread_count * sizeof(DigitOffsets));
+    gn_assert_with_message(offsets, "Could not allocate digit offsets for radix sort!");
+
+    RadixSortBarrier barrier = {};
+    barrier.thread_count = thread_count;
+
+    bool skip_pass = false;     // Written by thread 0 between the barriers
+
+    // Every thread runs all of the passes, so threads are only started once per sort
+    auto sort_passes = [&](u32 thread_index)
+    {
+        T* source = data;
+        T* destination = buffer;
+
+        u64* thread_offsets = offsets[thread_index];
+
+        const u64 start = min(thread_index * chunk_size, count);
+        const u64 end   = min(start + chunk_size, count);
+
+        for (u32 shift = 0; shift < 8 * sizeof(Key); shift += 8)
+        {
+            platform_zero_memory(thread_offsets, RADIX_SORT_DIGIT_COUNT * sizeof(u64));
+
+            for (u64 i = start; i < end; i++)
+                thread_offsets[(key_function(source[i]) >> shift) & 0xFF]++;
+
+            radix_sort_barrier_wait(barrier);
+
+            if (thread_index == 0)
+            {
+                // Turn the counts into where each thread writes its first element of each digit
+                u64 offset = 0;
+                skip_pass = false;
+                for (u32 digit = 0; digit < RADIX_SORT_DIGIT_COUNT; digit++)
+                {
+                    const u64 digit_start = offset;
+
+                    for (u32 i = 0; i < thread_count; i++)
+                    {
+                        const u64 digit_count = offsets[i][digit];
+                        offsets[i][digit] = offset;
+                        offset += digit_count;
+                    }
+
+                    // Pass wouldn't change anything
+                    if (offset - digit_start == count)
+                        skip_pass = true;
+                }
+            }
+
+            radix_sort_barrier_wait(barrier);
+
+            if (skip_pass)
+                continue;
+
+            for (u64 i = start; i < end; i++)
+                destination[thread_offsets[(key_function(source[i]) >> shift) & 0xFF]++] = source[i];
+
+            swap(source, destination);
+
+            // Next pass reads what the other threads just wrote
+            radix_sort_barrier_wait(barrier);
+        }
+
+        if (thread_index == 0 && source != data)
+            platform_copy_memory(data, source, count * sizeof(T));
+    };
+
+    radix_sort_run(thread_count, sort_passes);
+
+    allocator_free(allocator, offsets, thread_count * sizeof(DigitOffsets));
+    allocator_free(allocator, buffer, count * sizeof(T), alignof(T));
+}
+
+// Buffer comes from the array's allocator
+template <typename T, typename KeyFunction>
+inline void radix_sort(DynamicArray<T>& arr, KeyFunction key_function)
+{
+    radix_sort(arr.data, arr.size, key_function, arr.allocator);
+}
+
+#undef RADIX_SORT_DIGIT_COUNT
+#undef RADIX_SORT_MAX_THREADS
+#undef RADIX_SORT_MIN_THREAD_CHUNK
+#undef RADIX_SORT_INSERTION_SORT_THRESHOLD
+
+#undef SORT_PARTIAL_INSERTION_SORT_LIMIT
+#undef SORT_NINTHER_THRESHOLD
+#undef SORT_INSERTION_SORT_THRESHOLD
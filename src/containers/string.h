@@ -8,12 +8,16 @@
 #include "core/logger.h"
 #include "math/common.h"
 #include "platform/platform.h"
+#include "core/allocator.h"
 
 struct String
 {
     char* data;
     u64 size;
 
+    // Only used by strings that own their data
+    Allocator* allocator;
+
     const char& operator[](const u64 index) const
     {
         gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %, string: %)", index, size, *this);
@@ -22,14 +26,15 @@ struct String
 };
 
 template<>
-inline String make(Type<String>, const char* cstr)
+inline String make(Type<String>, const char* cstr, int size, Allocator* allocator)
 {
     String str;
 
-    str.size = strlen(cstr);
+    str.size = size;
+    str.allocator = allocator;
 
     const u64 data_size = (str.size + 1) * sizeof(char);
-    str.data = (char*) platform_allocate(data_size);
+    str.data = (char*) allocator_allocate(str.allocator, data_size);
     gn_assert_with_message(str.data, "Could not allocate data for string!");
 
     platform_copy_memory(str.data, cstr, data_size);
@@ -40,52 +45,57 @@ inline String make(Type<String>, const char* cstr)
 template<>
 inline String make(Type<String>, const char* cstr, int size)
 {
-    String str;
-
-    str.size = size;
-
-    const u64 data_size = (str.size + 1) * sizeof(char);
-    str.data = (char*) platform_allocate(data_size);
-    gn_assert_with_message(str.data, "Could not allocate data for string!");
+    return make(Type<String> {}, cstr, size, (Allocator*) nullptr);
+}
 
-    platform_copy_memory(str.data, cstr, data_size);
+template<>
+inline String make(Type<String>, const char* cstr, Allocator* allocator)
+{
+    return make(Type<String> {}, cstr, (int) strlen(cstr), allocator);
+}
 
-    return str;
+template<>
+inline String make(Type<String>, const char* cstr)
+{
+    return make(Type<String> {}, cstr, (int) strlen(cstr), (Allocator*) nullptr);
 }
 
 inline String ref(char* cstr, int size)
 {
-    return String { cstr, (u64) size };
+    return String { cstr, (u64) size, nullptr };
 }
 
 inline String ref(char* cstr, u64 size)
 {
-    return String { cstr, size };
+    return String { cstr, size, nullptr };
 }
 
 inline String ref(char* cstr)
 {
-    return String { cstr, strlen(cstr) };
+    return String { cstr, strlen(cstr), nullptr };
 }
 
+// Copy uses the same allocator as the original
 inline String copy(const String& other)
 {
     String str;
 
     str.size = other.size;
+    str.allocator = other.allocator;
 
     const u64 data_size = str.size * sizeof(char);
-    str.data = (char*) platform_allocate(data_size);
+    str.data = (char*) allocator_allocate(str.allocator, data_size + 1);
     gn_assert_with_message(str.data, "Could not allocate data for string!");
 
     platform_copy_memory(str.data, other.data, data_size);
+    str.data[str.size] = '\0';
 
     return str;
 }
 
 inline void free(String& str)
 {
-    platform_free(str.data);
+    allocator_free(str.allocator, str.data, (str.size + 1) * sizeof(char));
 
     str.data = nullptr;
     str.size = 0;
@@ -94,9 +104,11 @@ inline void free(String& str)
 // Reallocates
 inline void resize(String& str, u64 size)
 {
-    str.size = size;
-    str.data = (char*) platform_reallocate(str.data, str.size * sizeof(char));
+    str.data = (char*) allocator_reallocate(str.allocator, str.data, (str.size + 1) * sizeof(char), (size + 1) * sizeof(char));
     gn_assert_with_message(str.data, "Could not reallocate data for string!");
+
+    str.size = size;
+    str.data[str.size] = '\0';
 }
 
 inline void reverse(String& str)
@@ -110,16 +122,6 @@ inline void reverse(String& str)
     }
 }
 
-inline String get_substring(String src, u64 start = 0Ui64, u64 length = _UI64_MAX)
-{
-    String str;
-
-    str.data = src.data + start;
-    str.size = min(src.size - start, length);
-
-    return str;
-}
-
 inline bool operator==(const String str1, const String str2)
 {
     if (str1.size != str2.size)
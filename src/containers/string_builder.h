@@ -1,31 +1,215 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
 #include "core/types.h"
-#include "darray.h"
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/allocator.h"
+#include "core/utils.h"
+#include "math/common.h"
 #include "string.h"
 #include "platform/platform.h"
 
-using StringBuilder = DynamicArray<String>;
+// Appends go straight into one growable buffer, so building a string
+// only allocates when the buffer runs out of space. finish() hands the
+// buffer over as a String without copying it.
 
-String build_string(const StringBuilder& builder)
+// Enough for any 64 bit integer in base 2 plus a sign
+#define STRING_BUILDER_NUMBER_SIZE 66
+
+struct StringBuilder
+{
+    char* data;
+    u64   size;
+    u64   capacity;     // Always leaves room for a null terminator
+
+    Allocator* allocator;
+};
+
+template<>
+inline StringBuilder make(Type<StringBuilder>, u64 start_cap, Allocator* allocator)
+{
+    StringBuilder builder;
+
+    builder.allocator = allocator;
+    builder.capacity = max(start_cap, 16ull);
+    builder.size = 0;
+    builder.data = (char*) allocator_allocate(builder.allocator, builder.capacity * sizeof(char));
+    gn_assert_with_message(builder.data, "Could not allocate data for string builder!");
+
+    return builder;
+}
+
+template<>
+inline StringBuilder make(Type<StringBuilder>, u64 start_cap)
+{
+    return make(Type<StringBuilder> {}, start_cap, (Allocator*) nullptr);
+}
+
+template<>
+inline StringBuilder make(Type<StringBuilder>)
+{
+    return make(Type<StringBuilder> {}, 256ull, (Allocator*) nullptr);
+}
+
+inline void free(StringBuilder& builder)
+{
+    allocator_free(builder.allocator, builder.data, builder.capacity * sizeof(char));
+
+    builder.data = nullptr;
+    builder.size = builder.capacity = 0;
+}
+
+inline void clear(StringBuilder& builder)
+{
+    builder.size = 0;
+}
+
+// Makes sure count more characters (and the null terminator) fit without reallocating
+inline void reserve(StringBuilder& builder, u64 count)
+{
+    const u64 required = builder.size + count + 1;
+    if (required <= builder.capacity)
+        return;
+
+    const u64 new_capacity = max(2 * builder.capacity, required);
+
+    char* new_data = (char*) allocator_reallocate(builder.allocator, builder.data, builder.capacity * sizeof(char), new_capacity * sizeof(char));
+    gn_assert_with_message(new_data, "Could not reallocate data for string builder!");
+
+    builder.data = new_data;
+    builder.capacity = new_capacity;
+}
+
+inline StringBuilder& append(StringBuilder& builder, char ch)
+{
+    reserve(builder, 1);
+    builder.data[builder.size++] = ch;
+
+    return builder;
+}
+
+inline StringBuilder& append(StringBuilder& builder, const String str)
+{
+    reserve(builder, str.size);
+
+    platform_copy_memory(builder.data + builder.size, str.data, str.size * sizeof(char));
+    builder.size += str.size;
+
+    return builder;
+}
+
+inline StringBuilder& append(StringBuilder& builder, const char* cstr)
 {
-    u64 total_size = 0;
-    for (u64 i = 0; i < builder.size; i++)
-        total_size += builder[i].size;
-    
-    // Initialize new string
-    String str;
-    str.size = total_size;
-    str.data = (char*) platform_allocate(str.size * sizeof(char));
+    return append(builder, String { (char*) cstr, strlen(cstr), nullptr });
+}
 
-    // Copy strings to new string
+// Numbers are written straight into the buffer by to_string
+template <typename Integer>
+inline StringBuilder& append_int(StringBuilder& builder, Integer integer, u32 radix = 10)
+{
+    reserve(builder, STRING_BUILDER_NUMBER_SIZE);
+
+    String digits = { builder.data + builder.size, STRING_BUILDER_NUMBER_SIZE };
+    to_string(digits, integer, radix);
+    builder.size += digits.size;
+
+    return builder;
+}
+
+template <typename Float>
+inline StringBuilder& append_float(StringBuilder& builder, Float number, u32 after_decimal = 4)
+{
+    reserve(builder, 2 * STRING_BUILDER_NUMBER_SIZE);
+
+    String digits = { builder.data + builder.size, 2 * STRING_BUILDER_NUMBER_SIZE };
+    to_string(digits, number, after_decimal);
+    builder.size += digits.size;
+
+    return builder;
+}
+
+// Used by append_format to pick the right append for each argument
+inline void append_item(StringBuilder& builder, const char* cstr) { append(builder, cstr); }
+inline void append_item(StringBuilder& builder, char* cstr)       { append(builder, (const char*) cstr); }
+inline void append_item(StringBuilder& builder, char ch)          { append(builder, ch); }
+inline void append_item(StringBuilder& builder, const String str) { append(builder, str); }
+inline void append_item(StringBuilder& builder, bool boolean)     { append(builder, boolean ? "true" : "false"); }
+inline void append_item(StringBuilder& builder, s32 integer)      { append_int(builder, integer); }
+inline void append_item(StringBuilder& builder, s64 integer)      { append_int(builder, integer); }
+inline void append_item(StringBuilder& builder, u32 integer)      { append_int(builder, integer); }
+inline void append_item(StringBuilder& builder, u64 integer)      { append_int(builder, integer); }
+inline void append_item(StringBuilder& builder, f32 number)       { append_float(builder, number); }
+inline void append_item(StringBuilder& builder, f64 number)       { append_float(builder, number); }
+
+inline StringBuilder& append_format(StringBuilder& builder, const char* format)
+{
+    // Only %% can be left at this point
+    for (u64 offset = 0; format[offset] != '\0'; offset++)
+    {
+        append(builder, format[offset]);
+
+        if (format[offset] == '%' && format[offset + 1] == '%')
+            offset++;
+    }
+
+    return builder;
+}
+
+// Same format as print, each % is replaced with the next argument and %% is a literal %
+template <typename T, typename... Types>
+inline StringBuilder& append_format(StringBuilder& builder, const char* format, const T& item, Types... args)
+{
     u64 offset = 0;
-    for (u64 i = 0; i < builder.size; i++)
+    while (format[offset] != '\0')
+    {
+        if (format[offset] != '%')
+        {
+            append(builder, format[offset]);
+            offset++;
+            continue;
+        }
+
+        // Encountered a %
+        if (format[offset + 1] != '%')  // append item if not followed by another %
+        {
+            append_item(builder, item);
+            return append_format(builder, format + offset + 1, args...);
+        }
+
+        // Encountered another %
+        append(builder, '%');
+        offset += 2;
+    }
+
+    return builder;
+}
+
+// View into the builder, only valid until the next append
+inline String ref(const StringBuilder& builder)
+{
+    return String { builder.data, builder.size, nullptr };
+}
+
+// Hands the buffer over to the returned string, the builder is empty after this.
+// Extra capacity is trimmed off so the string can be freed like any other.
+inline String finish(StringBuilder& builder)
+{
+    if (builder.size + 1 != builder.capacity)
     {
-        platform_copy_memory(str.data + offset, builder[i].data, builder[i].size * sizeof(char));
-        offset += builder[i].size;
+        builder.data = (char*) allocator_reallocate(builder.allocator, builder.data, builder.capacity * sizeof(char), (builder.size + 1) * sizeof(char));
+        gn_assert_with_message(builder.data, "Could not reallocate data for string builder!");
     }
 
+    builder.data[builder.size] = '\0';
+
+    String str = { builder.data, builder.size, builder.allocator };
+
+    builder.data = nullptr;
+    builder.size = builder.capacity = 0;
+
     return str;
-}
\ No newline at end of file
+}
+
+#undef STRING_BUILDER_NUMBER_SIZE
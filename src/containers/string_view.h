@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "core/types.h"
+#include "core/common.h"
+#include "core/logger.h"
+#include "math/common.h"
+#include "string.h"
+
+// Read only window into characters owned by someone else. Nothing in
+// here allocates, so views are only valid as long as whatever they point
+// into. Views are not null terminated.
+
+struct StringView
+{
+    const char* data;
+    u64 size;
+
+    const char& operator[](const u64 index) const
+    {
+        gn_assert_with_message(index < size, "Index out of bounds! (index: %, view size: %)", index, size);
+        return data[index];
+    }
+
+    const char* begin() const { return data; }
+    const char* end()   const { return data + size; }
+};
+
+inline StringView view(const char* cstr, u64 size)
+{
+    return StringView { cstr, size };
+}
+
+inline StringView view(const char* cstr)
+{
+    return StringView { cstr, strlen(cstr) };
+}
+
+inline StringView view(const String str)
+{
+    return StringView { str.data, str.size };
+}
+
+// Allocates a null terminated copy
+template<>
+inline String make(Type<String>, StringView str, Allocator* allocator)
+{
+    String result;
+
+    result.size = str.size;
+    result.allocator = allocator;
+    result.data = (char*) allocator_allocate(result.allocator, (result.size + 1) * sizeof(char));
+    gn_assert_with_message(result.data, "Could not allocate data for string!");
+
+    platform_copy_memory(result.data, str.data, result.size * sizeof(char));
+    result.data[result.size] = '\0';
+
+    return result;
+}
+
+template<>
+inline String make(Type<String>, StringView str)
+{
+    return make(Type<String> {}, str, (Allocator*) nullptr);
+}
+
+inline bool operator==(const StringView str1, const StringView str2)
+{
+    return (str1.size == str2.size) && (memcmp(str1.data, str2.data, str1.size) == 0);
+}
+
+inline bool operator!=(const StringView str1, const StringView str2)
+{
+    return !(str1 == str2);
+}
+
+inline bool is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+// Clamps to the end of the view instead of asserting
+inline StringView substring(const StringView str, u64 start, u64 length = UINT64_MAX)
+{
+    start = min(start, str.size);
+    return StringView { str.data + start, min(str.size - start, length) };
+}
+
+// Returns the size of the view if the needle isn't found
+inline u64 find(const StringView str, char needle, u64 start = 0ull)
+{
+    for (u64 i = start; i < str.size; i++)
+    {
+        if (str.data[i] == needle)
+            return i;
+    }
+
+    return str.size;
+}
+
+inline u64 find(const StringView str, const StringView needle, u64 start = 0ull)
+{
+    if (needle.size == 0)
+        return min(start, str.size);
+
+    if (needle.size > str.size)
+        return str.size;
+
+    // Only compare the rest when the first character matches
+    for (u64 i = start; i + needle.size <= str.size; i++)
+    {
+        i = find(str, needle.data[0], i);
+        if (i + needle.size > str.size)
+            break;
+
+        if (memcmp(str.data + i, needle.data, needle.size) == 0)
+            return i;
+    }
+
+    return str.size;
+}
+
+inline u64 find_last(const StringView str, char needle)
+{
+    for (u64 i = str.size; i > 0; i--)
+    {
+        if (str.data[i - 1] == needle)
+            return i - 1;
+    }
+
+    return str.size;
+}
+
+inline bool starts_with(const StringView str, const StringView prefix)
+{
+    return (prefix.size <= str.size) && (memcmp(str.data, prefix.data, prefix.size) == 0);
+}
+
+inline bool ends_with(const StringView str, const StringView suffix)
+{
+    return (suffix.size <= str.size) && (memcmp(str.data + str.size - suffix.size, suffix.data, suffix.size) == 0);
+}
+
+inline StringView trim_left(const StringView str)
+{
+    u64 start = 0;
+    while (start < str.size && is_whitespace(str.data[start]))
+        start++;
+
+    return StringView { str.data + start, str.size - start };
+}
+
+inline StringView trim_right(const StringView str)
+{
+    u64 size = str.size;
+    while (size > 0 && is_whitespace(str.data[size - 1]))
+        size--;
+
+    return StringView { str.data, size };
+}
+
+inline StringView trim(const StringView str)
+{
+    return trim_right(trim_left(str));
+}
+
+// Splits around the first delimiter, the delimiter itself isn't part of either half.
+// Returns false (and puts everything in before) if there is no delimiter.
+inline bool split(const StringView str, char delimiter, StringView& before, StringView& after)
+{
+    const u64 index = find(str, delimiter);
+
+    before = StringView { str.data, index };
+    after  = (index < str.size) ? StringView { str.data + index + 1, str.size - index - 1 } : StringView { str.data + str.size, 0 };
+
+    return index < str.size;
+}
+
+// Iterates over the pieces between delimiters, empty pieces are kept:
+// for (StringView line : split(content, '\n')) { ... }
+struct StringSplit
+{
+    struct Iterator
+    {
+        StringView remaining;
+        StringView current;
+        char delimiter;
+        bool has_more;      // False once the last piece has been split off
+        bool done;
+
+        StringView operator*() const { return current; }
+
+        Iterator& operator++()
+        {
+            if (has_more)
+                has_more = split(remaining, delimiter, current, remaining);
+            else
+                done = true;
+
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const { return done != other.done; }
+    };
+
+    StringView str;
+    char delimiter;
+
+    Iterator begin() const
+    {
+        Iterator it = { str, StringView { str.data, 0 }, delimiter, true, false };
+        return ++it;
+    }
+
+    Iterator end() const
+    {
+        Iterator it = {};
+        it.done = true;
+        return it;
+    }
+};
+
+inline StringSplit split(const StringView str, char delimiter)
+{
+    return StringSplit { str, delimiter };
+}
+
+// Iterates over the pieces between any of the delimiters, empty pieces are skipped:
+// for (StringView word : tokenize(line, view(" \t"))) { ... }
+struct StringTokenizer
+{
+    struct Iterator
+    {
+        StringView remaining;
+        StringView current;
+        StringView delimiters;
+
+        StringView operator*() const { return current; }
+
+        Iterator& operator++()
+        {
+            // Skip leading delimiters
+            u64 start = 0;
+            while (start < remaining.size && find(delimiters, remaining.data[start]) < delimiters.size)
+                start++;
+
+            u64 end = start;
+            while (end < remaining.size && find(delimiters, remaining.data[end]) == delimiters.size)
+                end++;
+
+            current   = StringView { remaining.data + start, end - start };
+            remaining = StringView { remaining.data + end, remaining.size - end };
+
+            return *this;
+        }
+
+        // Finished once there are no characters left in the current token
+        bool operator!=(const Iterator& other) const { return current.size != 0; }
+    };
+
+    StringView str;
+    StringView delimiters;
+
+    Iterator begin() const
+    {
+        Iterator it = { str, StringView { str.data, 0 }, delimiters };
+        return ++it;
+    }
+
+    Iterator end() const { return Iterator {}; }
+};
+
+inline StringTokenizer tokenize(const StringView str, const StringView delimiters)
+{
+    return StringTokenizer { str, delimiters };
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/allocator.h"
+#include "math/common.h"
+#include "platform/platform.h"
+#include "darray.h"
+#include "string_view.h"
+
+// Editable text stored as a gap buffer: the characters before and after
+// the edit position sit on either side of an unused gap, so typing at the
+// same place only moves the gap instead of the whole text.
+// Lines are tracked separately along with a layout cache for each one. Edits
+// only mark the lines they touch as dirty and the renderer re-measures those,
+// every other line keeps its cached glyph positions.
+// The lines are a gap buffer of their own with the gap right after the last
+// edited line. Lines before it store where they start from the beginning of
+// the text and lines after it from the end, so an edit doesn't have to update
+// any line but its own and finding the line of a position is a binary search.
+
+#define TEXT_BUFFER_MIN_GAP_SIZE      64
+#define TEXT_BUFFER_MIN_LINE_GAP_SIZE 16
+
+struct TextLine
+{
+    u64 length;     // Not counting the '\n' at the end
+    u64 offset;     // From the start or the end of the text depending on the side of the gap, use line_start()
+
+    // Layout cache, filled in by whoever renders the text. Positions are for
+    // a font size of 1 so they can be scaled to whatever size is rendered.
+    DynamicArray<f32> advances;     // Where each character starts on the line
+    f32  width;
+    bool dirty;     // Needs to be measured again
+};
+
+struct TextBuffer
+{
+    char* data;
+    u64   capacity;
+    u64   gap_start;
+    u64   gap_end;
+
+    // Always has at least one line
+    TextLine* lines;
+    u64 line_capacity;
+    u64 line_gap_start;
+    u64 line_gap_end;
+
+    Allocator* allocator;
+};
+
+// Characters in a range, split in two if the range goes over the gap
+struct TextBufferSlice
+{
+    StringView before_gap;
+    StringView after_gap;
+};
+
+template<>
+inline TextBuffer make(Type<TextBuffer>, u64 start_cap, Allocator* allocator)
+{
+    TextBuffer buffer;
+
+    buffer.allocator = allocator;
+    buffer.capacity = max(start_cap, (u64) TEXT_BUFFER_MIN_GAP_SIZE);
+    buffer.gap_start = 0;
+    buffer.gap_end = buffer.capacity;
+    buffer.data = (char*) allocator_allocate(buffer.allocator, buffer.capacity * sizeof(char));
+    gn_assert_with_message(buffer.data, "Could not allocate data for text buffer!");
+
+    buffer.line_capacity = TEXT_BUFFER_MIN_LINE_GAP_SIZE;
+    buffer.lines = (TextLine*) allocator_allocate(buffer.allocator, buffer.line_capacity * sizeof(TextLine), alignof(TextLine));
+    gn_assert_with_message(buffer.lines, "Could not allocate lines for text buffer!");
+
+    buffer.lines[0] = {};
+    buffer.lines[0].advances.allocator = allocator;
+    buffer.lines[0].dirty = true;
+
+    buffer.line_gap_start = 1;
+    buffer.line_gap_end = buffer.line_capacity;
+
+    return buffer;
+}
+
+template<>
+inline TextBuffer make(Type<TextBuffer>, u64 start_cap)
+{
+    return make(Type<TextBuffer> {}, start_cap, (Allocator*) nullptr);
+}
+
+template<>
+inline TextBuffer make(Type<TextBuffer>)
+{
+    return make(Type<TextBuffer> {}, 1024ull, (Allocator*) nullptr);
+}
+
+inline TextBuffer& insert(TextBuffer& buffer, u64 position, const StringView text);
+
+// Starts out with a copy of text
+template<>
+inline TextBuffer make(Type<TextBuffer>, StringView text, Allocator* allocator)
+{
+    TextBuffer buffer = make(Type<TextBuffer> {}, text.size + TEXT_BUFFER_MIN_GAP_SIZE, allocator);
+    insert(buffer, 0, text);
+
+    return buffer;
+}
+
+template<>
+inline TextBuffer make(Type<TextBuffer>, StringView text)
+{
+    return make(Type<TextBuffer> {}, text, (Allocator*) nullptr);
+}
+
+// Number of characters in the buffer
+inline u64 length(const TextBuffer& buffer)
+{
+    return buffer.capacity - (buffer.gap_end - buffer.gap_start);
+}
+
+inline u64 line_count(const TextBuffer& buffer)
+{
+    return buffer.line_capacity - (buffer.line_gap_end - buffer.line_gap_start);
+}
+
+static inline u64 text_buffer_line_slot(const TextBuffer& buffer, u64 line_index)
+{
+    return (line_index < buffer.line_gap_start) ? line_index : line_index + buffer.line_gap_end - buffer.line_gap_start;
+}
+
+inline TextLine& get_line(TextBuffer& buffer, u64 line_index)
+{
+    gn_assert_with_message(line_index < line_count(buffer), "Line out of bounds! (line: %, line count: %)", line_index, line_count(buffer));
+    return buffer.lines[text_buffer_line_slot(buffer, line_index)];
+}
+
+inline const TextLine& get_line(const TextBuffer& buffer, u64 line_index)
+{
+    gn_assert_with_message(line_index < line_count(buffer), "Line out of bounds! (line: %, line count: %)", line_index, line_count(buffer));
+    return buffer.lines[text_buffer_line_slot(buffer, line_index)];
+}
+
+inline void free(TextBuffer& buffer)
+{
+    for (u64 i = 0; i < line_count(buffer); i++)
+        free(get_line(buffer, i).advances);
+
+    allocator_free(buffer.allocator, buffer.lines, buffer.line_capacity * sizeof(TextLine), alignof(TextLine));
+    allocator_free(buffer.allocator, buffer.data, buffer.capacity * sizeof(char));
+
+    buffer.data = nullptr;
+    buffer.lines = nullptr;
+    buffer.capacity = buffer.gap_start = buffer.gap_end = 0;
+    buffer.line_capacity = buffer.line_gap_start = buffer.line_gap_end = 0;
+}
+
+inline char char_at(const TextBuffer& buffer, u64 position)
+{
+    gn_assert_with_message(position < length(buffer), "Position out of bounds! (position: %, text length: %)", position, length(buffer));
+    return (position < buffer.gap_start) ? buffer.data[position] : buffer.data[position + buffer.gap_end - buffer.gap_start];
+}
+
+inline TextBufferSlice slice(const TextBuffer& buffer, u64 start, u64 count)
+{
+    gn_assert_with_message(start + count <= length(buffer), "Slice out of bounds! (start: %, count: %, text length: %)", start, count, length(buffer));
+
+    const u64 gap_size = buffer.gap_end - buffer.gap_start;
+
+    if (start + count <= buffer.gap_start)
+        return TextBufferSlice { view(buffer.data + start, count), view(buffer.data + buffer.gap_end, 0) };
+
+    if (start >= buffer.gap_start)
+        return TextBufferSlice { view(buffer.data + start + gap_size, count), view(buffer.data + buffer.gap_end, 0) };
+
+    const u64 before_count = buffer.gap_start - start;
+    return TextBufferSlice { view(buffer.data + start, before_count), view(buffer.data + buffer.gap_end, count - before_count) };
+}
+
+// Position of the first character of a line
+inline u64 line_start(const TextBuffer& buffer, u64 line_index)
+{
+    gn_assert_with_message(line_index < line_count(buffer), "Line out of bounds! (line: %, line count: %)", line_index, line_count(buffer));
+
+    if (line_index < buffer.line_gap_start)
+        return buffer.lines[line_index].offset;
+
+    return length(buffer) - buffer.lines[text_buffer_line_slot(buffer, line_index)].offset;
+}
+
+// Returns the line the position is on and where on the line it is
+inline u64 line_at(const TextBuffer& buffer, u64 position, u64& out_column)
+{
+    gn_assert_with_message(position <= length(buffer), "Position out of bounds! (position: %, text length: %)", position, length(buffer));
+
+    // Last line that starts at or before the position
+    u64 low = 0;
+    u64 high = line_count(buffer) - 1;
+    while (low < high)
+    {
+        const u64 middle = low + (high - low + 1) / 2;
+        if (line_start(buffer, middle) <= position)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    out_column = position - line_start(buffer, low);
+    return low;
+}
+
+// Marks every line as dirty, for when the text is going to be rendered with a different font
+inline void invalidate_layout(TextBuffer& buffer)
+{
+    for (u64 i = 0; i < line_count(buffer); i++)
+        get_line(buffer, i).dirty = true;
+}
+
+static inline void text_buffer_move_gap(TextBuffer& buffer, u64 position)
+{
+    if (position < buffer.gap_start)
+    {
+        const u64 count = buffer.gap_start - position;
+        platform_move_memory(buffer.data + buffer.gap_end - count, buffer.data + position, count * sizeof(char));
+
+        buffer.gap_start -= count;
+        buffer.gap_end   -= count;
+    }
+    else if (position > buffer.gap_start)
+    {
+        const u64 count = position - buffer.gap_start;
+        platform_move_memory(buffer.data + buffer.gap_start, buffer.data + buffer.gap_end, count * sizeof(char));
+
+        buffer.gap_start += count;
+        buffer.gap_end   += count;
+    }
+}
+
+// Makes sure count more characters fit in the gap
+static inline void text_buffer_reserve(TextBuffer& buffer, u64 count)
+{
+    const u64 gap_size = buffer.gap_end - buffer.gap_start;
+    if (count <= gap_size)
+        return;
+
+    const u64 new_capacity = max(2 * buffer.capacity, length(buffer) + count + TEXT_BUFFER_MIN_GAP_SIZE);
+
+    char* new_data = (char*) allocator_reallocate(buffer.allocator, buffer.data, buffer.capacity * sizeof(char), new_capacity * sizeof(char));
+    gn_assert_with_message(new_data, "Could not reallocate data for text buffer!");
+
+    // Text after the gap moves to the end of the new allocation
+    const u64 after_gap_count = buffer.capacity - buffer.gap_end;
+    platform_move_memory(new_data + new_capacity - after_gap_count, new_data + buffer.gap_end, after_gap_count * sizeof(char));
+
+    buffer.data = new_data;
+    buffer.gap_end = new_capacity - after_gap_count;
+    buffer.capacity = new_capacity;
+}
+
+// Lines that cross the gap switch between counting from the start and from the end of the text,
+// so this has to happen while the text still has the length the offsets were made with
+static inline void text_buffer_move_line_gap(TextBuffer& buffer, u64 line_index)
+{
+    const u64 text_length = length(buffer);
+
+    while (buffer.line_gap_start > line_index)
+    {
+        TextLine line = buffer.lines[--buffer.line_gap_start];
+        line.offset = text_length - line.offset;
+        buffer.lines[--buffer.line_gap_end] = line;
+    }
+
+    while (buffer.line_gap_start < line_index)
+    {
+        TextLine line = buffer.lines[buffer.line_gap_end++];
+        line.offset = text_length - line.offset;
+        buffer.lines[buffer.line_gap_start++] = line;
+    }
+}
+
+// Makes sure count more lines fit in the line gap
+static inline void text_buffer_reserve_lines(TextBuffer& buffer, u64 count)
+{
+    const u64 gap_size = buffer.line_gap_end - buffer.line_gap_start;
+    if (count <= gap_size)
+        return;
+
+    const u64 new_capacity = max(2 * buffer.line_capacity, line_count(buffer) + count + TEXT_BUFFER_MIN_LINE_GAP_SIZE);
+
+    TextLine* new_lines = (TextLine*) allocator_reallocate(buffer.allocator, buffer.lines, buffer.line_capacity * sizeof(TextLine), new_capacity * sizeof(TextLine), alignof(TextLine));
+    gn_assert_with_message(new_lines, "Could not reallocate lines for text buffer!");
+
+    const u64 after_gap_count = buffer.line_capacity - buffer.line_gap_end;
+    platform_move_memory(new_lines + new_capacity - after_gap_count, new_lines + buffer.line_gap_end, after_gap_count * sizeof(TextLine));
+
+    buffer.lines = new_lines;
+    buffer.line_gap_end = new_capacity - after_gap_count;
+    buffer.line_capacity = new_capacity;
+}
+
+inline TextBuffer& insert(TextBuffer& buffer, u64 position, const StringView text)
+{
+    u64 column;
+    const u64 line_index = line_at(buffer, position, column);
+
+    // Edited line goes right before the gap, nothing on either side of it has to change then
+    text_buffer_move_line_gap(buffer, line_index + 1);
+
+    u64 new_line_count = 0;
+    for (char ch : text)
+        new_line_count += (ch == '\n');
+
+    text_buffer_reserve_lines(buffer, new_line_count);
+
+    text_buffer_reserve(buffer, text.size);
+    text_buffer_move_gap(buffer, position);
+
+    platform_copy_memory(buffer.data + buffer.gap_start, text.data, text.size * sizeof(char));
+    buffer.gap_start += text.size;
+
+    TextLine& line = buffer.lines[line_index];
+    line.dirty = true;
+
+    if (new_line_count == 0)
+    {
+        line.length += text.size;
+        return buffer;
+    }
+
+    // The line gets split at the position, everything after it ends up at the end of the last new line.
+    // New lines go into the gap all at once so big pastes don't shift the other lines over and over.
+    const u64 rest_of_line = line.length - column;
+
+    u64 current_line = line_index;
+    u64 current_length = column;
+    for (u64 i = 0; i < text.size; i++)
+    {
+        if (text.data[i] == '\n')
+        {
+            buffer.lines[current_line].length = current_length;
+
+            current_line = buffer.line_gap_start++;
+            buffer.lines[current_line] = {};
+            buffer.lines[current_line].offset = position + i + 1;
+            buffer.lines[current_line].advances.allocator = buffer.allocator;
+            buffer.lines[current_line].dirty = true;
+
+            current_length = 0;
+        }
+        else
+        {
+            current_length++;
+        }
+    }
+
+    buffer.lines[current_line].length = current_length + rest_of_line;
+
+    return buffer;
+}
+
+inline TextBuffer& remove(TextBuffer& buffer, u64 position, u64 count)
+{
+    gn_assert_with_message(position + count <= length(buffer), "Trying to remove out of bounds! (position: %, count: %, text length: %)", position, count, length(buffer));
+
+    if (count == 0)
+        return buffer;
+
+    u64 first_column, last_column;
+    const u64 first_line = line_at(buffer, position, first_column);
+    const u64 last_line  = line_at(buffer, position + count, last_column);
+
+    // Removed lines end up right after the gap, so they're dropped by growing it
+    text_buffer_move_line_gap(buffer, first_line + 1);
+
+    // Whatever is left of the last line gets joined onto the first one
+    TextLine& line = buffer.lines[first_line];
+    line.length = first_column + (get_line(buffer, last_line).length - last_column);
+    line.dirty = true;
+
+    for (u64 i = first_line + 1; i <= last_line; i++)
+        free(get_line(buffer, i).advances);
+
+    buffer.line_gap_end += last_line - first_line;
+
+    text_buffer_move_gap(buffer, position);
+    buffer.gap_end += count;
+
+    return buffer;
+}
+
+#undef TEXT_BUFFER_MIN_GAP_SIZE
+#undef TEXT_BUFFER_MIN_LINE_GAP_SIZE
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Array that reserves address space for its max capacity up front and commits
+// pages as it grows. Elements never move, so growing doesn't copy anything and
+// pointers into the array stay valid, and pages past the end are never backed
+// by memory. Meant for big builders that could end up being gigabytes.
+
+#define VIRTUAL_ARRAY_MIN_COMMIT_SIZE (64 * 1024)    // Commits at least this many bytes at a time
+
+template <typename T>
+struct VirtualArray
+{
+    T*  data;
+    u64 size;
+    u64 capacity;       // Fits in the committed pages
+    u64 max_capacity;   // Fits in the reserved range
+
+    u64 committed_size; // Bytes
+
+    T& operator[](const u64 index)
+    {
+        gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %)", index, size);
+        return data[index];
+    }
+
+    const T& operator[](const u64 index) const
+    {
+        gn_assert_with_message(index < size, "Index out of bounds! (index: %, array size: %)", index, size);
+        return data[index];
+    }
+};
+
+static inline u64 virtual_array_round_to_pages(u64 size)
+{
+    static const u64 page_size = platform_get_page_size();
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+// Nothing is committed until the first element is added
+template <typename T>
+inline VirtualArray<T> make(Type<VirtualArray<T>>, u64 max_capacity)
+{
+    VirtualArray<T> arr = {};
+
+    arr.max_capacity = max_capacity;
+    arr.data = (T*) platform_reserve_memory(virtual_array_round_to_pages(max_capacity * sizeof(T)));
+    gn_assert_with_message(arr.data, "Could not reserve memory for virtual array! (max capacity: %)", max_capacity);
+
+    return arr;
+}
+
+template <typename T>
+inline void free(VirtualArray<T>& arr)
+{
+    platform_release_memory(arr.data, virtual_array_round_to_pages(arr.max_capacity * sizeof(T)));
+
+    arr.data = nullptr;
+    arr.size = arr.capacity = arr.max_capacity = arr.committed_size = 0;
+}
+
+template <typename T>
+inline void clear(VirtualArray<T>& arr)
+{
+    arr.size = 0;
+}
+
+// Commits enough pages for new_capacity elements, never shrinks
+template <typename T>
+inline void reserve(VirtualArray<T>& arr, u64 new_capacity)
+{
+    if (new_capacity <= arr.capacity)
+        return;
+
+    gn_assert_with_message(new_capacity <= arr.max_capacity, "Virtual array ran out of reserved space! (requested: %, max capacity: %)", new_capacity, arr.max_capacity);
+
+    const u64 reserved_size = virtual_array_round_to_pages(arr.max_capacity * sizeof(T));
+    const u64 new_committed_size = min(virtual_array_round_to_pages(max(new_capacity * sizeof(T), arr.committed_size + VIRTUAL_ARRAY_MIN_COMMIT_SIZE)), reserved_size);
+
+    const bool committed = platform_commit_memory((u8*) arr.data + arr.committed_size, new_committed_size - arr.committed_size);
+    gn_assert_with_message(committed, "Could not commit memory for virtual array! (committed: %, requested: %)", arr.committed_size, new_committed_size);
+
+    arr.committed_size = new_committed_size;
+    arr.capacity = min(arr.committed_size / sizeof(T), arr.max_capacity);
+}
+
+// Gives back the committed pages past the last element
+template <typename T>
+inline void trim(VirtualArray<T>& arr)
+{
+    const u64 used_size = virtual_array_round_to_pages(arr.size * sizeof(T));
+    if (used_size == arr.committed_size)
+        return;
+
+    platform_decommit_memory((u8*) arr.data + used_size, arr.committed_size - used_size);
+
+    arr.committed_size = used_size;
+    arr.capacity = min(arr.committed_size / sizeof(T), arr.max_capacity);
+}
+
+template <typename T>
+inline VirtualArray<T>& append(VirtualArray<T>& arr, const T& elem)
+{
+    if (arr.size >= arr.capacity)
+        reserve(arr, arr.size + 1);
+
+    arr.data[arr.size++] = elem;
+    return arr;
+}
+
+template <typename T>
+inline VirtualArray<T>& append_many(VirtualArray<T>& arr, const T* elems, u64 count)
+{
+    if (arr.size + count > arr.capacity)
+        reserve(arr, arr.size + count);
+
+    platform_copy_memory(arr.data + arr.size, elems, count * sizeof(T));
+    arr.size += count;
+
+    return arr;
+}
+
+template <typename T>
+inline T pop(VirtualArray<T>& arr)
+{
+    gn_assert_with_message(arr.size > 0, "Trying to pop elements from an array that has 0 elements!");
+    return arr.data[--arr.size];
+}
+
+#undef VIRTUAL_ARRAY_MIN_COMMIT_SIZE
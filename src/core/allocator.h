@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/memory_tracker.h"
+#include "platform/platform.h"
+
+// Containers remember the allocator they were made with and use it for
+// all of their allocations. A null allocator means the platform heap,
+// so containers that were zero initialized still work as expected.
+
+struct Allocator
+{
+    void* (*allocate)(void* context, u64 size, u64 alignment);
+    void* (*reallocate)(void* context, void* block, u64 old_size, u64 new_size, u64 alignment);
+    void  (*free)(void* context, void* block, u64 size, u64 alignment);
+
+    void* context;
+};
+
+// What the platform heap gives out anyway, anything above this goes through
+// the aligned platform functions. A block has to be reallocated and freed
+// with the same alignment it was allocated with.
+constexpr u64 allocator_default_alignment = 16;
+
+inline void* allocator_allocate(Allocator* allocator, u64 size, u64 alignment = allocator_default_alignment)
+{
+    if (!allocator)
+    {
+        // Tagged as containers unless the caller pushed something more specific
+        memory_tracker_push_default_tag(MemoryTag::CONTAINERS);
+        void* block = (alignment > allocator_default_alignment) ? platform_allocate_aligned(size, alignment) : platform_allocate(size);
+        memory_tracker_pop_tag();
+
+        return block;
+    }
+
+    return allocator->allocate(allocator->context, size, alignment);
+}
+
+inline void* allocator_reallocate(Allocator* allocator, void* block, u64 old_size, u64 new_size, u64 alignment = allocator_default_alignment)
+{
+    if (!allocator)
+    {
+        memory_tracker_push_default_tag(MemoryTag::CONTAINERS);
+        void* new_block = (alignment > allocator_default_alignment) ? platform_reallocate_aligned(block, new_size, alignment) : platform_reallocate(block, new_size);
+        memory_tracker_pop_tag();
+
+        return new_block;
+    }
+
+    return allocator->reallocate(allocator->context, block, old_size, new_size, alignment);
+}
+
+inline void allocator_free(Allocator* allocator, void* block, u64 size, u64 alignment = allocator_default_alignment)
+{
+    if (!allocator)
+    {
+        if (alignment > allocator_default_alignment)
+            platform_free_aligned(block);
+        else
+            platform_free(block);
+
+        return;
+    }
+
+    allocator->free(allocator->context, block, size, alignment);
+}
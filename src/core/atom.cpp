@@ -0,0 +1,172 @@
+#include "atom.h"
+
+#include <atomic>
+#include <emmintrin.h>
+#include "core/types.h"
+#include "core/logger.h"
+#include "containers/string.h"
+#include "containers/hash.h"
+#include "containers/hash_table.h"
+#include "platform/platform.h"
+
+// Strings are packed into big blocks that are never moved or freed,
+// so the Strings handed out by atom_string() stay valid forever.
+constexpr u64 atom_arena_block_size = 64 * 1024;
+
+// Strings for the ids are stored in fixed size pages so a page
+// never moves once it's allocated and lookups by id don't need the lock.
+constexpr u32 atom_page_size = 1024;
+constexpr u32 atom_max_pages = 1024;
+
+// Only relies on zero initialization so it's usable during static initialization of other files
+static struct
+{
+    std::atomic<u32> lock;      // 0 is unlocked, 1 is locked and 2 is locked with threads waiting
+    bool initialized;
+
+    // Keys point into the arena
+    HashTable<HashedString, Atom> lookup;
+
+    String* pages[atom_max_pages];
+    u32 count;
+
+    char* block;
+    u64 block_used;
+    u64 block_capacity;
+} atom_table;
+
+static inline void atom_table_lock()
+{
+    // Lookups are short so spin for a bit before going to sleep
+    for (u32 i = 0; i < 64; i++)
+    {
+        u32 unlocked = 0;
+        if (atom_table.lock.compare_exchange_weak(unlocked, 1, std::memory_order_acquire))
+            return;
+
+        _mm_pause();
+    }
+
+    // Leaves the lock marked as waited on, which at worst costs the unlock an extra wake
+    while (atom_table.lock.exchange(2, std::memory_order_acquire) != 0)
+        platform_wait_on_address(atom_table.lock, 2);
+}
+
+static inline void atom_table_unlock()
+{
+    if (atom_table.lock.exchange(0, std::memory_order_release) == 2)
+        platform_wake_one(atom_table.lock);
+}
+
+// Expects the lock to be held
+static inline void atom_table_init()
+{
+    atom_table.lookup = make<HashTable<HashedString, Atom>>();
+
+    // Id 0 is reserved for ATOM_INVALID
+    atom_table.pages[0] = (String*) platform_allocate(atom_page_size * sizeof(String));
+    gn_assert_with_message(atom_table.pages[0], "Could not allocate atom page!");
+
+    atom_table.pages[0][0] = String { nullptr, 0, nullptr };
+    atom_table.count = 1;
+
+    atom_table.initialized = true;
+}
+
+// Expects the lock to be held
+static inline String atom_table_store(const String str)
+{
+    const u64 size = str.size + 1;
+
+    if (atom_table.block_used + size > atom_table.block_capacity)
+    {
+        // Really long strings get a block of their own
+        const u64 capacity = (size > atom_arena_block_size) ? size : atom_arena_block_size;
+
+        // The rest of the previous block is wasted but it's small enough to not matter
+        atom_table.block = (char*) platform_allocate(capacity);
+        gn_assert_with_message(atom_table.block, "Could not allocate atom arena block! (size: %)", capacity);
+
+        atom_table.block_used = 0;
+        atom_table.block_capacity = capacity;
+    }
+
+    char* data = atom_table.block + atom_table.block_used;
+    platform_copy_memory(data, str.data, str.size);
+    data[str.size] = '\0';
+
+    atom_table.block_used += size;
+
+    return String { data, str.size, nullptr };
+}
+
+Atom atom_intern(const HashedString& str)
+{
+    atom_table_lock();
+
+    if (!atom_table.initialized)
+        atom_table_init();
+
+    auto elem = find(atom_table.lookup, str);
+    if (elem)
+    {
+        const Atom atom = elem.value();
+        atom_table_unlock();
+        return atom;
+    }
+
+    const u32 id = atom_table.count;
+    const u32 page = id / atom_page_size;
+    gn_assert_with_message(page < atom_max_pages, "Ran out of atoms! (max atoms: %)", atom_max_pages * atom_page_size);
+
+    if (!atom_table.pages[page])
+    {
+        atom_table.pages[page] = (String*) platform_allocate(atom_page_size * sizeof(String));
+        gn_assert_with_message(atom_table.pages[page], "Could not allocate atom page!");
+    }
+
+    const String stored = atom_table_store(str.string);
+    atom_table.pages[page][id % atom_page_size] = stored;
+    atom_table.count++;
+
+    const Atom atom = Atom { id };
+    put_with_hash(atom_table.lookup, HashedString { stored, str.hash }, str.hash, atom);
+
+    atom_table_unlock();
+    return atom;
+}
+
+Atom atom_intern(const String str)
+{
+    return atom_intern(hashed(str));
+}
+
+Atom atom_find(const HashedString& str)
+{
+    atom_table_lock();
+
+    Atom atom = ATOM_INVALID;
+
+    if (atom_table.initialized)
+    {
+        auto elem = find(atom_table.lookup, str);
+        if (elem)
+            atom = elem.value();
+    }
+
+    atom_table_unlock();
+    return atom;
+}
+
+Atom atom_find(const String str)
+{
+    return atom_find(hashed(str));
+}
+
+String atom_string(const Atom atom)
+{
+    gn_assert_with_message(atom.id != ATOM_INVALID.id, "Tried to get the string of an invalid atom!");
+
+    // Pages never move so this doesn't need the lock
+    return atom_table.pages[atom.id / atom_page_size][atom.id % atom_page_size];
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/types.h"
+#include "containers/string.h"
+#include "containers/hash.h"
+
+// Atoms are interned strings. Every distinct string gets a stable 32 bit id
+// so comparing atoms is just an integer compare. The strings themselves are
+// stored (null terminated) in a global arena and live for the whole program.
+// The atom table is safe to use from multiple threads.
+
+struct Atom
+{
+    u32 id;
+};
+
+// Id 0 is never handed out, it's returned when a string isn't found
+constexpr Atom ATOM_INVALID = Atom { 0 };
+
+Atom atom_intern(const String str);
+Atom atom_intern(const HashedString& str);
+
+// Returns ATOM_INVALID if the string was never interned
+Atom atom_find(const String str);
+Atom atom_find(const HashedString& str);
+
+// Points into the atom arena, don't free it
+String atom_string(const Atom atom);
+
+inline bool operator==(const Atom a, const Atom b)
+{
+    return a.id == b.id;
+}
+
+inline bool operator!=(const Atom a, const Atom b)
+{
+    return a.id != b.id;
+}
+
+template<>
+struct Hasher<Atom>
+{
+    inline Hash operator()(Atom const& key) const
+    {
+        return hash_integer(key.id);
+    }
+};
@@ -14,4 +14,48 @@
 	#define GN_FORCE_INLINE __attribute__((always_inline)) inline
 #else
 	#define GN_FORCE_INLINE inline
-#endif
\ No newline at end of file
+#endif
+
+// Bit scan macros (result is undefined when x is 0)
+#if defined(GN_COMPILER_MSVC)
+	#include <intrin.h>
+	#define GN_COUNT_TRAILING_ZEROS_32(x) _tzcnt_u32(x)
+	#define GN_COUNT_TRAILING_ZEROS_64(x) _tzcnt_u64(x)
+#elif defined(GN_COMPILER_GCC) || defined(GN_COMPILER_CLANG)
+	#define GN_COUNT_TRAILING_ZEROS_32(x) __builtin_ctz(x)
+	#define GN_COUNT_TRAILING_ZEROS_64(x) __builtin_ctzll(x)
+#else
+	static inline unsigned int gn_count_trailing_zeros_32_fallback(unsigned int x)
+	{
+		unsigned int count = 0;
+		while (!(x & 1u)) { x >>= 1; count++; }
+		return count;
+	}
+
+	static inline unsigned int gn_count_trailing_zeros_64_fallback(unsigned long long x)
+	{
+		unsigned int count = 0;
+		while (!(x & 1ull)) { x >>= 1; count++; }
+		return count;
+	}
+
+	#define GN_COUNT_TRAILING_ZEROS_32(x) gn_count_trailing_zeros_32_fallback(x)
+	#define GN_COUNT_TRAILING_ZEROS_64(x) gn_count_trailing_zeros_64_fallback(x)
+#endif
+
+// Number of set bits
+#if defined(GN_COMPILER_MSVC)
+	#include <intrin.h>
+	#define GN_POPULATION_COUNT_64(x) __popcnt64(x)
+#elif defined(GN_COMPILER_GCC) || defined(GN_COMPILER_CLANG)
+	#define GN_POPULATION_COUNT_64(x) __builtin_popcountll(x)
+#else
+	static inline unsigned int gn_population_count_64_fallback(unsigned long long x)
+	{
+		unsigned int count = 0;
+		while (x) { x &= x - 1; count++; }
+		return count;
+	}
+
+	#define GN_POPULATION_COUNT_64(x) gn_population_count_64_fallback(x)
+#endif
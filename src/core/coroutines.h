@@ -8,7 +8,7 @@
 
 #define COROUTINE_NESTING_LIMIT 8
 #define COROUTINE_CALL_OFFSET   1024 * 1024
-#define COROUTINE_STACK_SIZE    512ui64
+#define COROUTINE_STACK_SIZE    512ull
 
 struct Coroutine
 {
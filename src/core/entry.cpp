@@ -3,6 +3,9 @@
 #include "application/application.h"
 #include "graphics/graphics.h"
 #include "core/input_processing.h"
+#include "core/linear_arena.h"
+#include "core/frame_pacer.h"
+#include "core/memory_tracker.h"
 #include "platform/platform.h"
 #include "engine/imgui.h"
 
@@ -40,7 +43,7 @@ int main()
         return 1;
     }
 
-    graphics_set_vsync(true);
+    graphics_set_vsync(app.vsync);
     graphics_set_clear_color(app.clear_color.r, app.clear_color.g, app.clear_color.b, app.clear_color.a);
 
     // Initialize engine stuff
@@ -49,10 +52,27 @@ int main()
 
     app.on_init(app);
 
+    FramePacer frame_pacer = make<FramePacer>(app.target_frame_rate);
+
     f32 prev_time = platform_get_time();
 
+#ifdef GN_DEBUG
+    u64 prev_allocation_count = platform_get_allocation_count();
+#endif // GN_DEBUG
+
     while (app.is_running)
     {
+        // Everything from the last frame's arena is gone now
+        reset(frame_arena());
+
+#ifdef GN_DEBUG
+        const u64 allocation_count = platform_get_allocation_count();
+        app.frame_allocation_count = allocation_count - prev_allocation_count;
+        prev_allocation_count = allocation_count;
+#endif // GN_DEBUG
+
+        memory_tracker_end_frame();
+
         app.time = platform_get_time();
         app.delta_time = min(app.time - prev_time, 0.2f);   // Max frame time is 0.2 secs
         prev_time = app.time;
@@ -69,6 +89,9 @@ int main()
         input_state_update(app);
 
         Imgui::update();
+
+        frame_pacer_end_frame(frame_pacer);
+        app.frame_times = frame_pacer_get_stats(frame_pacer);
     }
 
     app.on_shutdown(app);
@@ -78,4 +101,6 @@ int main()
     // Shutdown engine stuff
 
     platform_window_shutdown(pstate);
+
+    memory_tracker_report_leaks();
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "frame_pacer.h"
+
+#include "core/types.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Sleeps overshoot by up to a scheduler tick, spinning for the last 2 ms covers that
+constexpr f64 default_spin_time = 0.002;
+
+constexpr f32 bucket_width = 0.0001f;
+
+static inline u32 frame_time_bucket(f32 frame_time)
+{
+    return min((u32) (frame_time / bucket_width), (u32) FRAME_PACER_BUCKET_COUNT - 1);
+}
+
+static void record_frame_time(FramePacer& pacer, f32 frame_time)
+{
+    // Drop the oldest frame once the history is full
+    if (pacer.history_count == FRAME_PACER_HISTORY_SIZE)
+        pacer.buckets[frame_time_bucket(pacer.frame_times[pacer.history_index])]--;
+    else
+        pacer.history_count++;
+
+    pacer.frame_times[pacer.history_index] = frame_time;
+    pacer.history_index = (pacer.history_index + 1) % FRAME_PACER_HISTORY_SIZE;
+
+    pacer.buckets[frame_time_bucket(frame_time)]++;
+}
+
+FramePacer make(Type<FramePacer>, f32 target_frame_rate)
+{
+    FramePacer pacer = {};
+
+    pacer.spin_time = default_spin_time;
+    pacer.frame_start = platform_get_time();
+    frame_pacer_set_target(pacer, target_frame_rate);
+
+    return pacer;
+}
+
+void frame_pacer_set_target(FramePacer& pacer, f32 target_frame_rate)
+{
+    pacer.target_frame_time = (target_frame_rate > 0.0f) ? 1.0 / (f64) target_frame_rate : 0.0;
+}
+
+void frame_pacer_end_frame(FramePacer& pacer)
+{
+    f64 now = platform_get_time();
+
+    if (pacer.target_frame_time > 0.0)
+    {
+        const f64 deadline = pacer.frame_start + pacer.target_frame_time;
+
+        // Sleep for the coarse part, the loop is there because sleeps can also wake up early
+        while (deadline - now > pacer.spin_time)
+        {
+            platform_thread_sleep(deadline - now - pacer.spin_time);
+            now = platform_get_time();
+        }
+
+        while (now < deadline)
+            now = platform_get_time();
+
+        record_frame_time(pacer, (f32) (now - pacer.frame_start));
+
+        // Keep the cadence from the deadline unless the frame was so late that catching up would mean rushing the next ones
+        pacer.frame_start = (now - deadline < pacer.target_frame_time) ? deadline : now;
+    }
+    else
+    {
+        record_frame_time(pacer, (f32) (now - pacer.frame_start));
+        pacer.frame_start = now;
+    }
+}
+
+FramePacerStats frame_pacer_get_stats(const FramePacer& pacer)
+{
+    FramePacerStats stats = {};
+    if (pacer.history_count == 0)
+        return stats;
+
+    for (u32 i = 0; i < pacer.history_count; i++)
+        stats.max = max(stats.max, pacer.frame_times[i]);
+
+    // Percentiles are the upper edge of the bucket they land in, so they're accurate to 0.1 ms
+    const u32 p50_count = (u32) ceilf(pacer.history_count * 0.50f);
+    const u32 p99_count = (u32) ceilf(pacer.history_count * 0.99f);
+
+    u32 count = 0;
+    bool found_p50 = false;
+    for (u32 i = 0; i < FRAME_PACER_BUCKET_COUNT; i++)
+    {
+        count += pacer.buckets[i];
+
+        if (!found_p50 && count >= p50_count)
+        {
+            stats.p50 = (i + 1) * bucket_width;
+            found_p50 = true;
+        }
+
+        if (count >= p99_count)
+        {
+            stats.p99 = (i + 1) * bucket_width;
+            break;
+        }
+    }
+
+    // The overflow bucket has no upper edge
+    stats.p50 = min(stats.p50, stats.max);
+    stats.p99 = min(stats.p99, stats.max);
+
+    return stats;
+}
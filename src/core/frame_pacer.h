@@ -0,0 +1,45 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/common.h"
+
+// Holds frames to a target rate by sleeping for most of the wait and spinning
+// on the clock for the last bit, since sleeps can overshoot by a millisecond or
+// two. Deadlines are spaced from each other rather than from when the frame
+// actually ended, so small errors don't add up over time.
+// Also keeps a histogram of the last few hundred frame times for percentiles.
+
+#define FRAME_PACER_HISTORY_SIZE   512
+#define FRAME_PACER_BUCKET_COUNT   1024     // 0.1 ms each, the last one holds everything slower
+
+struct FramePacerStats
+{
+    f32 p50;    // In seconds
+    f32 p99;
+    f32 max;
+};
+
+struct FramePacer
+{
+    f64 target_frame_time;  // 0 means frames aren't limited, only measured
+    f64 spin_time;          // How long before the deadline sleeping stops
+
+    f64 frame_start;
+
+    // Rolling history, the histogram only counts frames that are still in it
+    f32 frame_times[FRAME_PACER_HISTORY_SIZE];
+    u32 history_index;
+    u32 history_count;
+
+    u16 buckets[FRAME_PACER_BUCKET_COUNT];
+};
+
+// Target frame rate of 0 doesn't limit anything
+FramePacer make(Type<FramePacer>, f32 target_frame_rate);
+
+void frame_pacer_set_target(FramePacer& pacer, f32 target_frame_rate);
+
+// Call once at the end of every frame. Waits until it's time for the next one and records how long this one took.
+void frame_pacer_end_frame(FramePacer& pacer);
+
+FramePacerStats frame_pacer_get_stats(const FramePacer& pacer);
@@ -0,0 +1,17 @@
+#include "linear_arena.h"
+
+#include "core/types.h"
+
+// Big enough for a frame's worth of temporary strings and arrays
+constexpr u64 frame_arena_capacity = 4 * 1024 * 1024;
+
+static thread_local LinearArena frame_arena_instance = {};
+
+LinearArena& frame_arena()
+{
+    // Made the first time a thread uses it
+    if (!frame_arena_instance.data)
+        frame_arena_instance = make<LinearArena>(frame_arena_capacity);
+
+    return frame_arena_instance;
+}
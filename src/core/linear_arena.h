@@ -0,0 +1,155 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/common.h"
+#include "core/logger.h"
+#include "core/allocator.h"
+#include "core/memory_tracker.h"
+#include "math/common.h"
+#include "platform/platform.h"
+
+// Bump allocator over one fixed block. Allocating is just moving an offset
+// forward and everything is freed at once by resetting (or popping back to
+// a marker), so it's meant for temporary data with a clear lifetime.
+// Containers can opt into an arena by being made with arena_allocator(arena).
+
+#define LINEAR_ARENA_DEFAULT_ALIGNMENT 16
+
+struct LinearArena
+{
+    u8* data;
+    u64 size;
+    u64 capacity;
+    u64 peak;       // Highest size reached, useful for picking the capacity
+
+    Allocator allocator;
+};
+
+struct ArenaMarker
+{
+    u64 offset;
+};
+
+template<>
+inline LinearArena make(Type<LinearArena>, u64 capacity)
+{
+    LinearArena arena = {};
+
+    arena.capacity = capacity;
+
+    memory_tracker_push_tag(MemoryTag::ARENAS);
+    arena.data = (u8*) platform_allocate(arena.capacity);
+    memory_tracker_pop_tag();
+    gn_assert_with_message(arena.data, "Could not allocate data for linear arena! (capacity: %)", capacity);
+
+    return arena;
+}
+
+inline void free(LinearArena& arena)
+{
+    platform_free(arena.data);
+
+    arena.data = nullptr;
+    arena.size = arena.capacity = arena.peak = 0;
+}
+
+// Alignment has to be a power of 2. Returns nullptr if the arena is full, in every build,
+// so it's up to the caller to assert or fall back to something else.
+inline void* push(LinearArena& arena, u64 size, u64 alignment = LINEAR_ARENA_DEFAULT_ALIGNMENT)
+{
+    const u64 address = (u64) arena.data + arena.size;
+    const u64 padding = ((address + alignment - 1) & ~(alignment - 1)) - address;
+
+    if (arena.size + padding + size > arena.capacity)
+        return nullptr;
+
+    void* result = arena.data + arena.size + padding;
+
+    arena.size += padding + size;
+    arena.peak = (arena.size > arena.peak) ? arena.size : arena.peak;
+
+    return result;
+}
+
+template <typename T>
+inline T* push_array(LinearArena& arena, u64 count)
+{
+    return (T*) push(arena, count * sizeof(T), max((u64) alignof(T), (u64) LINEAR_ARENA_DEFAULT_ALIGNMENT));
+}
+
+inline ArenaMarker marker(const LinearArena& arena)
+{
+    return ArenaMarker { arena.size };
+}
+
+// Frees everything pushed after the marker was taken
+inline void pop_to_marker(LinearArena& arena, ArenaMarker marker)
+{
+    gn_assert_with_message(marker.offset <= arena.size, "Marker is past the end of the arena, was it popped already? (marker: %, size: %)", marker.offset, arena.size);
+    arena.size = marker.offset;
+}
+
+inline void reset(LinearArena& arena)
+{
+    arena.size = 0;
+}
+
+static void* linear_arena_allocate(void* context, u64 size, u64 alignment)
+{
+    return push(*(LinearArena*) context, size, max(alignment, (u64) LINEAR_ARENA_DEFAULT_ALIGNMENT));
+}
+
+// The last allocation can grow in place, anything else gets copied to the top of the arena.
+// Returns nullptr like push() if it doesn't fit, the old block is left as it was.
+static void* linear_arena_reallocate(void* context, void* block, u64 old_size, u64 new_size, u64 alignment)
+{
+    LinearArena& arena = *(LinearArena*) context;
+
+    if (block && (u8*) block + old_size == arena.data + arena.size)
+    {
+        const u64 block_offset = (u64) ((u8*) block - arena.data);
+        if (block_offset + new_size > arena.capacity)
+            return nullptr;
+
+        arena.size = block_offset + new_size;
+        arena.peak = (arena.size > arena.peak) ? arena.size : arena.peak;
+        return block;
+    }
+
+    void* new_block = push(arena, new_size, max(alignment, (u64) LINEAR_ARENA_DEFAULT_ALIGNMENT));
+    if (new_block && block)
+        platform_copy_memory(new_block, block, (old_size < new_size) ? old_size : new_size);
+
+    return new_block;
+}
+
+// Only the last allocation actually gets freed, the rest waits for a reset
+static void linear_arena_free(void* context, void* block, u64 size, u64)
+{
+    LinearArena& arena = *(LinearArena*) context;
+
+    if (block && (u8*) block + size == arena.data + arena.size)
+        arena.size = (u64) ((u8*) block - arena.data);
+}
+
+// Allocator that containers can be made with. Points at the arena so the arena can't be moved after this.
+inline Allocator* arena_allocator(LinearArena& arena)
+{
+    arena.allocator.allocate   = linear_arena_allocate;
+    arena.allocator.reallocate = linear_arena_reallocate;
+    arena.allocator.free       = linear_arena_free;
+    arena.allocator.context    = &arena;
+
+    return &arena.allocator;
+}
+
+// Every thread has its own frame arena. The main loop resets the main thread's
+// one at the start of every frame, so anything allocated from it only lives until then.
+LinearArena& frame_arena();
+
+inline Allocator* frame_allocator()
+{
+    return arena_allocator(frame_arena());
+}
+
+#undef LINEAR_ARENA_DEFAULT_ALIGNMENT
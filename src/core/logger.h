@@ -87,16 +87,18 @@ inline static void debug_msg_internal(FILE* filestream, const char* label, const
 #ifdef _MSC_VER
 #include <intrin.h>
 #define gn_break_point() __debugbreak()
+#define gn_function_signature __FUNCSIG__
 #else
 #define gn_break_point() __builtin_trap()
+#define gn_function_signature __PRETTY_FUNCTION__
 #endif
 
-#define gn_assert(x)                        if (!(x)) { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, __FUNCSIG__, __LINE__, #x); gn_break_point(); }
-#define gn_assert_with_message(x, msg, ...) if (!(x)) { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, __FUNCSIG__, __LINE__, msg, __VA_ARGS__); gn_break_point(); }
-#define gn_assert_not_implemented()         { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, __FUNCSIG__, __LINE__, "Function not implemented!"); gn_break_point(); }
+#define gn_assert(x)                        if (!(x)) { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, gn_function_signature, __LINE__, #x); gn_break_point(); }
+#define gn_assert_with_message(x, msg, ...) if (!(x)) { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, gn_function_signature, __LINE__, msg, ##__VA_ARGS__); gn_break_point(); }
+#define gn_assert_not_implemented()         { debug_msg_internal(stderr, "ASSERTION FAILED", __FILE__, gn_function_signature, __LINE__, "Function not implemented!"); gn_break_point(); }
 
-#define gn_warn(msg, ...)           debug_msg_internal(stdout, "WARNING", __FILE__, __FUNCSIG__, __LINE__, msg, __VA_ARGS__)
-#define gn_warn_if(cond, msg, ...)  if ((cond)) { debug_msg_internal(stdout, "WARNING", __FILE__, __FUNCSIG__, __LINE__, msg, __VA_ARGS__); }
+#define gn_warn(msg, ...)           debug_msg_internal(stdout, "WARNING", __FILE__, gn_function_signature, __LINE__, msg, ##__VA_ARGS__)
+#define gn_warn_if(cond, msg, ...)  if ((cond)) { debug_msg_internal(stdout, "WARNING", __FILE__, gn_function_signature, __LINE__, msg, ##__VA_ARGS__); }
 
 #else
 
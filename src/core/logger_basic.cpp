@@ -3,7 +3,10 @@
 #include <cstdlib>
 #include "core/types.h"
 #include "containers/string.h"
+#include "containers/string_view.h"
 #include "containers/bytes.h"
+#include "containers/hash.h"
+#include "atom.h"
 #include "utils.h"
 
 #define LOGGER_TEMP_BUFFER_SIZE 64
@@ -14,11 +17,32 @@ void print_to_file(FILE* file, const bool& boolean)
     print_to_file(file, (boolean) ? "true" : "false");
 }
 
+template <>
+void print_to_file(FILE* file, const StringView& str)
+{
+    // Views aren't null terminated so they're written with their size
+    fwrite(str.data, sizeof(char), str.size, file);
+}
+
 template <>
 void print_to_file(FILE* file, const String& str)
 {
-    for (u64 i = 0; i < str.size; i++)
-        print_to_file(file, str.data[i]);
+    print_to_file(file, view(str));
+}
+
+template <>
+void print_to_file(FILE* file, const HashedString& str)
+{
+    print_to_file(file, str.string);
+}
+
+template <>
+void print_to_file(FILE* file, const Atom& atom)
+{
+    if (atom == ATOM_INVALID)
+        print_to_file(file, "<invalid atom>");
+    else
+        print_to_file(file, atom_string(atom));
 }
 
 template <>
@@ -0,0 +1,112 @@
+#include "memory_tracker.h"
+
+#ifdef GN_TRACK_MEMORY
+
+#include <atomic>
+#include "core/types.h"
+#include "core/logger.h"
+
+constexpr u32 memory_tag_stack_size = 16;
+
+// Only relies on zero initialization since statics in other files allocate before main
+static struct
+{
+    std::atomic<u64> live_bytes;
+    std::atomic<u64> peak_bytes;
+    std::atomic<u64> live_allocations;
+    std::atomic<u64> total_allocations;
+    std::atomic<u64> current_frame_allocations;
+    std::atomic<u64> last_frame_allocations;
+} tag_stats[(u32) MemoryTag::NUM_TAGS];
+
+static thread_local struct
+{
+    MemoryTag tags[memory_tag_stack_size];
+    u32 size;
+} tag_stack;
+
+void memory_tracker_push_tag(MemoryTag tag)
+{
+    gn_assert_with_message(tag_stack.size < memory_tag_stack_size, "Memory tag stack overflow, is a pop missing? (max size: %)", memory_tag_stack_size);
+    tag_stack.tags[tag_stack.size++] = tag;
+}
+
+void memory_tracker_pop_tag()
+{
+    gn_assert_with_message(tag_stack.size > 0, "Memory tag stack is already empty!");
+    tag_stack.size--;
+}
+
+void memory_tracker_push_default_tag(MemoryTag tag)
+{
+    memory_tracker_push_tag((tag_stack.size > 0) ? tag_stack.tags[tag_stack.size - 1] : tag);
+}
+
+MemoryTag memory_tracker_current_tag()
+{
+    return (tag_stack.size > 0) ? tag_stack.tags[tag_stack.size - 1] : MemoryTag::GENERAL;
+}
+
+void memory_tracker_record_allocation(MemoryTag tag, u64 size)
+{
+    auto& stats = tag_stats[(u32) tag];
+
+    const u64 live_bytes = stats.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    stats.live_allocations.fetch_add(1, std::memory_order_relaxed);
+    stats.total_allocations.fetch_add(1, std::memory_order_relaxed);
+    stats.current_frame_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    u64 peak_bytes = stats.peak_bytes.load(std::memory_order_relaxed);
+    while (live_bytes > peak_bytes && !stats.peak_bytes.compare_exchange_weak(peak_bytes, live_bytes, std::memory_order_relaxed))
+        ;
+}
+
+void memory_tracker_record_free(MemoryTag tag, u64 size)
+{
+    auto& stats = tag_stats[(u32) tag];
+
+    stats.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    stats.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryTagStats memory_tracker_get_stats(MemoryTag tag)
+{
+    const auto& stats = tag_stats[(u32) tag];
+
+    MemoryTagStats result;
+    result.live_bytes        = stats.live_bytes.load(std::memory_order_relaxed);
+    result.peak_bytes        = stats.peak_bytes.load(std::memory_order_relaxed);
+    result.live_allocations  = stats.live_allocations.load(std::memory_order_relaxed);
+    result.total_allocations = stats.total_allocations.load(std::memory_order_relaxed);
+    result.frame_allocations = stats.last_frame_allocations.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+void memory_tracker_end_frame()
+{
+    for (auto& stats : tag_stats)
+        stats.last_frame_allocations.store(stats.current_frame_allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void memory_tracker_report_leaks()
+{
+    u64 leaked_bytes = 0;
+
+    for (u32 i = 0; i < (u32) MemoryTag::NUM_TAGS; i++)
+    {
+        const MemoryTagStats stats = memory_tracker_get_stats((MemoryTag) i);
+        if (stats.live_allocations == 0)
+            continue;
+
+        print("Memory still live at shutdown: % (% allocations, % bytes, peak % bytes)\n",
+              memory_tag_name((MemoryTag) i), stats.live_allocations, stats.live_bytes, stats.peak_bytes);
+
+        leaked_bytes += stats.live_bytes;
+    }
+
+    if (leaked_bytes == 0)
+        print("No memory still live at shutdown\n");
+}
+
+#endif // GN_TRACK_MEMORY
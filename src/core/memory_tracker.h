@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/types.h"
+
+// Opt-in heap tracking, only compiled in with GN_TRACK_MEMORY (build.bat debug track_memory).
+// Every platform allocation is tagged with whatever tag is on top of the calling
+// thread's tag stack, and live bytes, peak bytes and allocation counts are kept per tag.
+// Without GN_TRACK_MEMORY everything here does nothing and the stats are all 0.
+
+enum struct MemoryTag : u8
+{
+    GENERAL,        // Nothing more specific was pushed
+    CONTAINERS,     // Containers using the platform heap (null allocator)
+    ARENAS,
+    JSON,
+    TEXTURES,       // Includes pixel data uploaded to the GPU
+    PACKAGE,
+    UI,
+    NUM_TAGS
+};
+
+inline const char* memory_tag_name(MemoryTag tag)
+{
+    constexpr const char* names[(u32) MemoryTag::NUM_TAGS] = {
+        "General",
+        "Containers",
+        "Arenas",
+        "Json",
+        "Textures",
+        "Package",
+        "UI",
+    };
+
+    return names[(u32) tag];
+}
+
+struct MemoryTagStats
+{
+    u64 live_bytes;
+    u64 peak_bytes;
+    u64 live_allocations;
+    u64 total_allocations;
+    u64 frame_allocations;  // Allocations made during the last frame
+};
+
+#ifdef GN_TRACK_MEMORY
+
+constexpr bool memory_tracker_enabled = true;
+
+void memory_tracker_push_tag(MemoryTag tag);
+void memory_tracker_pop_tag();
+
+// Pushes tag only if nothing more specific is on the stack, otherwise pushes the current tag again
+void memory_tracker_push_default_tag(MemoryTag tag);
+
+MemoryTag memory_tracker_current_tag();
+
+// Called by the platform layer for heap blocks, and by hand for memory the heap doesn't see (like textures on the GPU)
+void memory_tracker_record_allocation(MemoryTag tag, u64 size);
+void memory_tracker_record_free(MemoryTag tag, u64 size);
+
+MemoryTagStats memory_tracker_get_stats(MemoryTag tag);
+
+// Moves this frame's allocation counts to frame_allocations and starts counting again
+void memory_tracker_end_frame();
+
+// Logs every tag that still has live allocations. Statics that are never freed show up here too.
+void memory_tracker_report_leaks();
+
+#else
+
+constexpr bool memory_tracker_enabled = false;
+
+inline void memory_tracker_push_tag(MemoryTag tag) {}
+inline void memory_tracker_pop_tag() {}
+inline void memory_tracker_push_default_tag(MemoryTag tag) {}
+
+inline MemoryTag memory_tracker_current_tag() { return MemoryTag::GENERAL; }
+
+inline void memory_tracker_record_allocation(MemoryTag tag, u64 size) {}
+inline void memory_tracker_record_free(MemoryTag tag, u64 size) {}
+
+inline MemoryTagStats memory_tracker_get_stats(MemoryTag tag) { return {}; }
+
+inline void memory_tracker_end_frame() {}
+inline void memory_tracker_report_leaks() {}
+
+#endif // GN_TRACK_MEMORY
@@ -145,7 +145,7 @@ void to_string(String& str, f32 number, u32 after_decimal)
     {
         str.data[str.size] = '.';
 
-        String fraction_string = { str.data + str.size + 1, old_size - str.size };
+        String fraction_string = { str.data + str.size + 1, old_size - str.size, nullptr };
 
         fractional *= pow(10.0, after_decimal);
         to_string(fraction_string, abs((s32) fractional));
@@ -170,7 +170,7 @@ void to_string(String& str, f64 number, u32 after_decimal)
     {
         str.data[str.size] = '.';
 
-        String fraction_string = { str.data + str.size + 1, old_size - str.size };
+        String fraction_string = { str.data + str.size + 1, old_size - str.size, nullptr };
 
         fractional *= pow(10.0, after_decimal);
         to_string(fraction_string, abs((s64) fractional));
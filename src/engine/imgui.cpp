@@ -4,6 +4,8 @@
 #include "core/types.h"
 #include "core/logger.h"
 #include "core/input.h"
+#include "core/atom.h"
+#include "core/memory_tracker.h"
 #include "platform/platform.h"
 #include "containers/bytes.h"
 #include "containers/darray.h"
@@ -68,14 +70,14 @@ static void init_white_texture(int width, int height)
     if (texture_get_existing(ref("White Texture"), ui_data.white_texture))
         return;
     
-    u8* pixels = (u8*) platform_allocate(width * height * 4);
+    u8* pixels = (u8*) platform_allocate_aligned(width * height * 4, 64);
     platform_set_memory(pixels, 0xFF, width * height * 4);
 
     TextureSettings settings;
     settings.min_filter = settings.max_filter = TextureSettings::Filter::NEAREST;
     ui_data.white_texture = texture_load_pixels(ref("White Texture"), pixels, width, height, 4, settings);
 
-    platform_free(pixels);
+    platform_free_aligned(pixels);
 }
 
 static void init_batches()
@@ -89,12 +91,12 @@ static void init_batches()
 
         // Compile Shaders
         gn_assert_with_message(
-            shader_compile_source(ui_data.quad_batch.shader, ref(ui_quad_vert_shader_source), Shader::Type::VERTEX),
+            shader_compile_source(ui_data.quad_batch.shader, view(ui_quad_vert_shader_source), Shader::Type::VERTEX),
             "Failed to compile UI Quad Vertex Shader! (shader source: %)", ui_quad_vert_shader_source
         );
 
         gn_assert_with_message(
-            shader_compile_source(ui_data.quad_batch.shader, ref(ui_quad_frag_shader_source), Shader::Type::FRAGMENT),
+            shader_compile_source(ui_data.quad_batch.shader, view(ui_quad_frag_shader_source), Shader::Type::FRAGMENT),
             "Failed to compile UI Quad Fragment Shader! (shader source: %)", ui_quad_frag_shader_source
         );
 
@@ -109,12 +111,12 @@ static void init_batches()
 
         // Compile Shaders
         gn_assert_with_message(
-            shader_compile_source(ui_data.font_batch.shader, ref(ui_font_vert_shader_source), Shader::Type::VERTEX),
+            shader_compile_source(ui_data.font_batch.shader, view(ui_font_vert_shader_source), Shader::Type::VERTEX),
             "Failed to compile UI Font Vertex Shader! (shader source: %)", ui_font_vert_shader_source
         );
 
         gn_assert_with_message(
-            shader_compile_source(ui_data.font_batch.shader, ref(ui_font_frag_shader_source), Shader::Type::FRAGMENT),
+            shader_compile_source(ui_data.font_batch.shader, view(ui_font_frag_shader_source), Shader::Type::FRAGMENT),
             "Failed to compile UI Font Fragment Shader! (shader source: %)", ui_font_frag_shader_source
         );
 
@@ -167,7 +169,9 @@ void init(const Application& app)
     ui_data.state_current_frame.hot = ui_data.state_current_frame.active = ui_data.state_current_frame.interacted = imgui_invalid_id;
     ui_data.state_prev_frame.hot = ui_data.state_prev_frame.active = ui_data.state_prev_frame.interacted = imgui_invalid_id;
 
+    memory_tracker_push_tag(MemoryTag::UI);
     init_batches();
+    memory_tracker_pop_tag();
 
     init_white_texture(4, 4);
 
@@ -208,7 +212,8 @@ static void flush_batch(ImguiBatchData& batch)
     for (u32 i = 0; i < batch.next_active_tex_slot; i++)
         texture_bind(batch.textures[i], i);
     
-    shader_set_uniform_1iv(batch.shader, ref("u_textures"), batch.next_active_tex_slot, active_tex_slots);
+    static const Atom u_textures = atom_intern(hashed_ref("u_textures"));
+    shader_set_uniform_1iv(batch.shader, u_textures, batch.next_active_tex_slot, active_tex_slots);
     
     // Bind and Update Data
     GLsizeiptr size = (u8*) batch.elem_vertices_ptr - (u8*) batch.elem_vertices_buffer;
@@ -257,60 +262,72 @@ Font font_load_from_json(const Json::Document& document, const String atlas_path
     // Load font data
     const Json::Value& data = document.start();
 
-    const Json::Object& atlas = data[ref("atlas")].object();
-    font.size = atlas[ref("size")].int64();
-    const s32 texture_width  = atlas[ref("width")].int64();
-    const s32 texture_height = atlas[ref("height")].int64();
-
-    const Json::Object& metrics = data[ref("metrics")].object();
-    font.line_height = metrics[ref("lineHeight")].float64();
-    font.ascender    = metrics[ref("ascender")].float64();
-    font.descender   = metrics[ref("descender")].float64();
-
-    const Json::Array& glyphs = data[ref("glyphs")].array();
+    const Json::Object& atlas = data[hashed_ref("atlas")].object();
+    font.size = atlas[hashed_ref("size")].int64();
+    const s32 texture_width  = atlas[hashed_ref("width")].int64();
+    const s32 texture_height = atlas[hashed_ref("height")].int64();
+
+    const Json::Object& metrics = data[hashed_ref("metrics")].object();
+    font.line_height = metrics[hashed_ref("lineHeight")].float64();
+    font.ascender    = metrics[hashed_ref("ascender")].float64();
+    font.descender   = metrics[hashed_ref("descender")].float64();
+
+    // Keys looked up for every glyph, so only find their atoms once
+    const Atom key_unicode      = atom_find(hashed_ref("unicode"));
+    const Atom key_unicode1     = atom_find(hashed_ref("unicode1"));
+    const Atom key_unicode2     = atom_find(hashed_ref("unicode2"));
+    const Atom key_advance      = atom_find(hashed_ref("advance"));
+    const Atom key_plane_bounds = atom_find(hashed_ref("planeBounds"));
+    const Atom key_atlas_bounds = atom_find(hashed_ref("atlasBounds"));
+    const Atom key_left         = atom_find(hashed_ref("left"));
+    const Atom key_bottom       = atom_find(hashed_ref("bottom"));
+    const Atom key_right        = atom_find(hashed_ref("right"));
+    const Atom key_top          = atom_find(hashed_ref("top"));
+
+    const Json::Array& glyphs = data[hashed_ref("glyphs")].array();
     for (u64 i = 0; i < glyphs.size(); i++)
     {
-        const u32 unicode = glyphs[i][ref("unicode")].int64();
+        const u32 unicode = glyphs[i][key_unicode].int64();
         
         Font::GlyphData& glyph_data = font.glyphs[unicode - ' '];
 
-        glyph_data.advance = glyphs[i][ref("advance")].float64();
+        glyph_data.advance = glyphs[i][key_advance].float64();
 
         {   // Plane bounds
-            const Json::Value& plane_bounds = glyphs[i][ref("planeBounds")];
+            const Json::Value& plane_bounds = glyphs[i][key_plane_bounds];
 
             if (plane_bounds.type() != Json::Type::NONE)
             {
                 glyph_data.plane_bounds = Vector4 {
-                    (f32) plane_bounds[ref("left")].float64(),
-                    (f32) plane_bounds[ref("bottom")].float64(),
-                    (f32) plane_bounds[ref("right")].float64(),
-                    (f32) plane_bounds[ref("top")].float64()
+                    (f32) plane_bounds[key_left].float64(),
+                    (f32) plane_bounds[key_bottom].float64(),
+                    (f32) plane_bounds[key_right].float64(),
+                    (f32) plane_bounds[key_top].float64()
                 };
             }
         }
 
         {   // Atlas bounds
-            const Json::Value& atlas_bounds = glyphs[i][ref("atlasBounds")];
+            const Json::Value& atlas_bounds = glyphs[i][key_atlas_bounds];
 
             if (atlas_bounds.type() != Json::Type::NONE)
             {
                 glyph_data.atlas_bounds = Vector4 {
-                    (f32) atlas_bounds[ref("left")].float64()   / texture_width,
-                    (f32) atlas_bounds[ref("top")].float64()    / texture_height,
-                    (f32) atlas_bounds[ref("right")].float64()  / texture_width,
-                    (f32) atlas_bounds[ref("bottom")].float64() / texture_height
+                    (f32) atlas_bounds[key_left].float64()   / texture_width,
+                    (f32) atlas_bounds[key_top].float64()    / texture_height,
+                    (f32) atlas_bounds[key_right].float64()  / texture_width,
+                    (f32) atlas_bounds[key_bottom].float64() / texture_height
                 };
             }
         }
     }
 
-    const Json::Array& kerning = data[ref("kerning")].array();
+    const Json::Array& kerning = data[hashed_ref("kerning")].array();
     font.kerning_table = make<Font::KerningTable>();
     for (u64 i = 0; i < kerning.size(); i++)
     {
-        s32 k_index = get_kerning_index(kerning[i][(ref("unicode1"))].int64(), kerning[i][(ref("unicode2"))].int64());
-        put(font.kerning_table, k_index, (f32) kerning[i][ref("advance")].float64());
+        s32 k_index = get_kerning_index(kerning[i][key_unicode1].int64(), kerning[i][key_unicode2].int64());
+        put(font.kerning_table, k_index, (f32) kerning[i][key_advance].float64());
     }
 
     return font;
@@ -424,6 +441,74 @@ Vector2 get_rendered_text_size(const String text, const Font& font, f32 size)
     return total_size;
 }
 
+// Fills in the line's layout cache at a font size of 1
+static void measure_text_line(TextLine& line, const TextBufferSlice& text, const Font& font)
+{
+    clear(line.advances);
+    if (line.advances.capacity < line.length)
+        resize(line.advances, line.length);
+
+    f32 x = 0.0f;
+    char previous_char = '\0';
+
+    const StringView parts[] = { text.before_gap, text.after_gap };
+    for (StringView part : parts)
+    {
+        for (char current_char : part)
+        {
+            f32 start = x;
+
+            if (current_char == '\t')
+            {
+                x += font.glyphs[0].advance * (4 - (line.advances.size % 4));
+            }
+            else if (current_char >= ' ' && current_char < 127)
+            {
+                if (previous_char >= ' ')
+                {
+                    const auto& kerning = find(font.kerning_table, get_kerning_index(current_char, previous_char));
+                    if (kerning)
+                        start += kerning.value();
+                }
+
+                x = start + font.glyphs[current_char - ' '].advance;
+            }
+
+            line.advances.data[line.advances.size++] = start;
+            previous_char = current_char;
+        }
+    }
+
+    line.width = x;
+    line.dirty = false;
+}
+
+static inline void update_text_line_layout(TextBuffer& buffer, u64 line_index, u64 start, const Font& font)
+{
+    TextLine& line = get_line(buffer, line_index);
+    if (line.dirty)
+        measure_text_line(line, slice(buffer, start, line.length), font);
+}
+
+Vector2 get_rendered_text_size(TextBuffer& buffer, const Font& font, f32 size)
+{
+    size = (size < 0.0f) ? font.size : size;
+
+    f32 width = 0.0f;
+    u64 start = 0;
+
+    for (u64 i = 0; i < line_count(buffer); i++)
+    {
+        update_text_line_layout(buffer, i, start, font);
+
+        const TextLine& line = get_line(buffer, i);
+        width = max(width, line.width);
+        start += line.length + 1;
+    }
+
+    return Vector2 { size * width, size * (font.ascender + (line_count(buffer) - 1) * font.line_height) };
+}
+
 Vector2 get_rendered_char_size(const char ch, const Font& font, f32 size)
 {
     switch (ch)
@@ -456,7 +541,7 @@ static void push_ui_quad(ImguiBatchData& batch, const Rect& rect, const Vector4&
     int texture_slot = batch.next_active_tex_slot;
     for (int i = 0; i < batch.next_active_tex_slot; i++)
     {
-        if (batch.textures[i].id == texture.id)
+        if (batch.textures[i] == texture)
         {
             texture_slot = i;
             break;
@@ -637,6 +722,51 @@ void render_text(const String text, const Font& font, const Vector3& top_left, f
     }
 }
 
+void render_text(TextBuffer& buffer, const Font& font, const Vector3& top_left, f32 size, const Vector4& tint, f32 max_height)
+{
+    size = (size < 0.0f) ? font.size : size;
+
+    Vector3 position = top_left;
+    position.y += size * font.ascender * 0.85f;
+
+    u64 start = 0;
+    for (u64 line_index = 0; line_index < line_count(buffer); line_index++)
+    {
+        if (max_height >= 0.0f && (line_index + 1) * size * font.line_height > max_height)
+            break;
+
+        update_text_line_layout(buffer, line_index, start, font);
+
+        const TextLine& line = get_line(buffer, line_index);
+        const TextBufferSlice text = slice(buffer, start, line.length);
+
+        u64 i = 0;
+        const StringView parts[] = { text.before_gap, text.after_gap };
+        for (StringView part : parts)
+        {
+            for (char current_char : part)
+            {
+                // Nothing to draw for whitespace
+                if (current_char > ' ' && current_char < 127)
+                {
+                    const Font::GlyphData& glyph = font.glyphs[current_char - ' '];
+
+                    Rect rect;
+                    rect.top_left = position + Vector3 { size * (line.advances.data[i] + glyph.plane_bounds.s), size * -glyph.plane_bounds.v, i * -0.00001f };
+                    rect.size = size * Vector2 { glyph.plane_bounds.u - glyph.plane_bounds.s, glyph.plane_bounds.v - glyph.plane_bounds.t };
+
+                    push_ui_quad(ui_data.font_batch, rect, glyph.atlas_bounds, font.atlas, tint);
+                }
+
+                i++;
+            }
+        }
+
+        start += line.length + 1;
+        position.y += size * font.line_height;
+    }
+}
+
 void render_char(const char ch, const Font& font, const Vector3& top_left, f32 size, const Vector4& tint)
 {
     switch (ch)
@@ -4,6 +4,7 @@
 #include "core/types.h"
 #include "containers/bytes.h"
 #include "containers/hash_table.h"
+#include "containers/text_buffer.h"
 #include "graphics/texture.h"
 #include "math/math.h"
 #include "serialization/json/json_document.h"
@@ -76,6 +77,7 @@ Font  font_load_from_bytes(const Bytes& bytes);
 // Utility Functions
 Vector2 get_rendered_text_size(const String text, const Font& font, f32 size = -1.0f);
 Vector2 get_rendered_char_size(const char ch, const Font& font, f32 size = -1.0f);
+Vector2 get_rendered_text_size(TextBuffer& buffer, const Font& font, f32 size = -1.0f);     // Measures dirty lines
 
 // Rendering UI
 void render_rect(const Rect& rect, const Vector4& color);
@@ -86,6 +88,9 @@ bool render_button(ID id, const Rect& rect, const Vector4& default_color = Vecto
 void render_text(const String text, const Font& font, const Vector3& top_left, f32 size = -1.0f, const Vector4& tint = Vector4(1.0f));
 void render_char(const char ch, const Font& font, const Vector3& top_left, f32 size = -1.0f, const Vector4& tint = Vector4(1.0f));
 
+// Only re-measures dirty lines and stops at the first line that goes past max_height (if it's not negative)
+void render_text(TextBuffer& buffer, const Font& font, const Vector3& top_left, f32 size = -1.0f, const Vector4& tint = Vector4(1.0f), f32 max_height = -1.0f);
+
 } // namespace Imgui
 
 void free(Imgui::Font& font);
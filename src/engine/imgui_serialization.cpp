@@ -56,22 +56,16 @@ Bytes font_encode_to_bytes(const Font& font)
     }
 
     {   // Kerning
-        u32 count = font.kerning_table.filled;
         append(bytes, Binary::ARRAY_2_BYTE);
-        Binary::append_integer(bytes, (u16) (count * 2));
+        Binary::append_integer(bytes, (u16) (font.kerning_table.count * 2));
 
-        for (u32 i = 0; count > 0 && i < font.kerning_table.capacity; i++)
+        for (auto elem : font.kerning_table)
         {
-            if (font.kerning_table.states[i] == Font::KerningTable::State::ALIVE)
-            {
-                append(bytes, Binary::INTEGER_S32);
-                Binary::append_integer(bytes, font.kerning_table.keys[i]);
-                
-                append(bytes, Binary::FLOAT_32);
-                Binary::append_float(bytes, font.kerning_table.values[i]);
-
-                count--;
-            }
+            append(bytes, Binary::INTEGER_S32);
+            Binary::append_integer(bytes, elem.key());
+            
+            append(bytes, Binary::FLOAT_32);
+            Binary::append_float(bytes, elem.value());
         }
     }
 
@@ -11,15 +11,16 @@ Bytes compress_bytes(const Bytes& uncompressed_bytes)
 {
     // The compressed bytes store the decompression ratio as a float at the beginning
 
-    u8* compressed_bytes = (u8*) platform_allocate(sizeof(f32) + uncompressed_bytes.size);
+    // Incompressible data can come out a bit bigger than it went in
     mz_ulong compressed_size = compressBound(uncompressed_bytes.size);
+    u8* compressed_bytes = (u8*) platform_allocate(sizeof(f32) + compressed_size);
 
     int status = mz_compress(compressed_bytes + sizeof(f32), &compressed_size, uncompressed_bytes.data, (mz_ulong) uncompressed_bytes.size);
     gn_assert_with_message(status == Z_OK, "Couldn't compress the given bytes!");
 
-    if (compressed_size != uncompressed_bytes.size)
+    if (compressed_size != compressBound(uncompressed_bytes.size))
     {
-        compressed_bytes = (u8*) platform_reallocate(compressed_bytes, (u64) compressed_size);
+        compressed_bytes = (u8*) platform_reallocate(compressed_bytes, sizeof(f32) + (u64) compressed_size);
         gn_assert_with_message(compressed_bytes, "Couldn't reallocate compressed bytes!");
     }
 
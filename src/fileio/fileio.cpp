@@ -1,16 +1,34 @@
 #include "fileio.h"
 
+#include <cerrno>
+#include <cstring>
 #include "core/logger.h"
 #include "containers/string.h"
+#include "containers/string_view.h"
 #include "containers/bytes.h"
 #include "containers/darray.h"
 
-String file_load_string(const String& filepath)
+#define FILEIO_MAX_PATH_SIZE 1024
+
+// Paths are views so they get null terminated on the stack before going to fopen
+static FILE* open_file(const StringView filepath, const char* mode)
 {
-    // TODO: Strings are not always null terminated. Do something about that!
-    FILE* file = fopen(filepath.data, "rb");
+    gn_assert_with_message(filepath.size < FILEIO_MAX_PATH_SIZE, "File path is too long! (filepath: \"%\")", filepath);
+
+    char path[FILEIO_MAX_PATH_SIZE];
+    platform_copy_memory(path, filepath.data, filepath.size);
+    path[filepath.size] = '\0';
+
+    FILE* file = fopen(path, mode);
     gn_assert_with_message(file, "Error opening file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
 
+    return file;
+}
+
+String file_load_string(const StringView filepath)
+{
+    FILE* file = open_file(filepath, "rb");
+
     fseek(file, 0, SEEK_END);
     int length = ftell(file);
     fseek(file, 0, SEEK_SET);
@@ -22,14 +40,12 @@ String file_load_string(const String& filepath)
 
     fclose(file);
 
-    return String { output.data, output.capacity - 1 };
+    return String { output.data, output.capacity - 1, nullptr };
 }
 
-Bytes file_load_bytes(const String& filepath)
+Bytes file_load_bytes(const StringView filepath)
 {
-    // TODO: Strings are not always null terminated. Do something about that!
-    FILE* file = fopen(filepath.data, "rb");
-    gn_assert_with_message(file, "Error opening file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
+    FILE* file = open_file(filepath, "rb");
 
     fseek(file, 0, SEEK_END);
     int length = ftell(file);
@@ -44,11 +60,9 @@ Bytes file_load_bytes(const String& filepath)
     return Bytes { output.data, output.capacity };
 }
 
-void file_write_string(const String& filepath, const String& string)
+void file_write_string(const StringView filepath, const StringView string)
 {
-    // TODO: Strings are not always null terminated. Do something about that!
-    FILE* file = fopen(filepath.data, "wb");
-    gn_assert_with_message(file, "Error opening file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
+    FILE* file = open_file(filepath, "wb");
 
     u64 written = fwrite(string.data, sizeof(u8), string.size, file);
     gn_assert_with_message(written == string.size, "Error writing to file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
@@ -57,15 +71,15 @@ void file_write_string(const String& filepath, const String& string)
     gn_assert_with_message(success == 0, "Error closing file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
 }
 
-void file_write_bytes(const String& filepath, const Bytes& bytes)
+void file_write_bytes(const StringView filepath, const Bytes& bytes)
 {
-    // TODO: Strings are not always null terminated. Do something about that!
-    FILE* file = fopen(filepath.data, "wb");
-    gn_assert_with_message(file, "Error opening file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
+    FILE* file = open_file(filepath, "wb");
 
     u64 written = fwrite(bytes.data, sizeof(u8), bytes.size, file);
     gn_assert_with_message(written == bytes.size, "Error writing to file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
 
     int success = fclose(file);
     gn_assert_with_message(success == 0, "Error closing file! (errno: \"%\", filepath: \"%\")", strerror(errno), filepath);
-}
\ No newline at end of file
+}
+
+#undef FILEIO_MAX_PATH_SIZE
\ No newline at end of file
@@ -2,10 +2,12 @@
 
 #include "core/types.h"
 #include "containers/string.h"
+#include "containers/string_view.h"
 #include "containers/bytes.h"
 
-String file_load_string(const String& filepath);
-Bytes  file_load_bytes(const String& filepath);
+// Loaded strings are null terminated
+String file_load_string(const StringView filepath);
+Bytes  file_load_bytes(const StringView filepath);
 
-void file_write_string(const String& filepath, const String& string);
-void file_write_bytes(const String& filepath, const Bytes& bytes);
\ No newline at end of file
+void file_write_string(const StringView filepath, const StringView string);
+void file_write_bytes(const StringView filepath, const Bytes& bytes);
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "engine/imgui.h"
 #include "containers/darray.h"
+#include "containers/small_array.h"
+#include "containers/sort.h"
 #include "containers/function.h"
 #include "containers/string.h"
 #include "core/coroutines.h"
@@ -12,9 +14,24 @@
 
 #include <stb_image.h>
 
-static DynamicArray<u64> game_windows_to_be_closed;
-static s32 game_top_most_window_id = -1;
-static s32 next_valid_window_id = 1;
+static SmallArray<u64, 8> game_windows_to_be_closed;
+static SlotHandle game_top_most_window = SLOT_HANDLE_INVALID;
+
+static inline SlotHandle game_window_handle(const GameData& data, u64 index)
+{
+    return column<GameWindowColumn::HANDLE>(data.game_windows)[index];
+}
+
+// Handles are unique among live windows so they work as Imgui IDs
+static inline s32 game_window_id(const GameData& data, u64 index)
+{
+    return (s32) game_window_handle(data, index).value;
+}
+
+static inline const Vector2& game_window_position(const GameData& data, u64 index)
+{
+    return column<GameWindowColumn::POSITION>(data.game_windows)[index];
+}
 
 constexpr f32 game_font_size_button = 16.0f;
 constexpr f32 game_padding_button_horizontal = 10.0f;
@@ -87,17 +104,15 @@ void import_raw_assets(GameData& data)
 
 void game_init(const Application& app, GameData& data)
 {
-    data.shortcuts = make<DynamicArray<GameShortcut>>(5Ui64);
+    data.shortcuts = make<DynamicArray<GameShortcut>>(5ull);
 
-    data.coroutine_handles     = make<DynamicArray<Coroutine>>(10Ui64);
-    data.active_game_windows   = make<DynamicArray<GameWindowRenderCallback>>(10Ui64);
-    data.game_window_positions = make<DynamicArray<Vector2>>(10Ui64);
-    data.game_window_ids       = make<DynamicArray<s32>>(10Ui64);
+    data.game_windows = make<GameWindowTable>(10ull);
+    data.game_window_rows = make<SlotMap<u64>>((u32) 10);
     game_reset(data);
 
-    game_windows_to_be_closed = make<DynamicArray<u64>>();
+    game_windows_to_be_closed = make<SmallArray<u64, 8>>();
 
-    next_valid_window_id = 1;
+    data.notes = make<TextBuffer>(view(notes_text, notes_text_size));
 
     data.showing_project_open_window = false;
     data.notification_active = false;
@@ -153,16 +168,18 @@ void game_init(const Application& app, GameData& data)
 
 void game_window_register(GameData& data, GameWindowRenderCallback callback, const Vector2& position)
 {
-    append(data.coroutine_handles, Coroutine {});
-    append(data.active_game_windows, callback);
-    append(data.game_window_positions, position);
-    append(data.game_window_ids, next_valid_window_id++);
+    const SlotHandle handle = insert(data.game_window_rows, data.game_windows.size);
+    append(data.game_windows, Coroutine {}, callback, position, handle);
 }
 
 void game_window_close(GameData& data, u64 index)
 {
+    // Window might have been closed already this frame
+    if (find(game_windows_to_be_closed, index) != game_windows_to_be_closed.size)
+        return;
+
     append(game_windows_to_be_closed, index);
-    coroutine_reset(data.coroutine_handles[index]);
+    coroutine_reset(column<GameWindowColumn::COROUTINE>(data.game_windows)[index]);
 }
 
 void game_shortcut_register(GameData& data, const GameShortcut& shortcut)
@@ -265,84 +282,60 @@ void game_shortcut_settings(const Application& app, GameData& data)
     game_window_register(data, game_window_settings, Vector2 {});
 }
 
-struct GameWindowData
+void game_render_active_windows(Application& app, GameData& data)
 {
-    Coroutine co;
-    GameWindowRenderCallback callback;
-    Vector2 position;
-    s32 window_id;
-};
+    // Columns are fetched every iteration since windows can register other windows
+    for (u64 i = 0; i < data.game_windows.size; i++)
+    {
+        GameWindowRenderCallback callback = column<GameWindowColumn::RENDER_CALLBACK>(data.game_windows)[i];
+        callback(column<GameWindowColumn::COROUTINE>(data.game_windows)[i], i, app, data);
+    }
+}
 
-void game_render_active_windows(Application& app, GameData& data)
+// Rows before first_row haven't moved
+static inline void game_window_update_rows(GameData& data, u64 first_row)
 {
-    // Render windows
-    for (u64 i = 0; i < data.active_game_windows.size; i++)
-        data.active_game_windows[i](data.coroutine_handles[i], i, app, data);
+    const SlotHandle* handles = column<GameWindowColumn::HANDLE>(data.game_windows);
+    for (u64 i = first_row; i < data.game_windows.size; i++)
+        *find(data.game_window_rows, handles[i]) = i;
 }
 
 void game_post_render(GameData& data)
 {
-    if (data.wallpaper_to_be_deleted.id)
+    if (data.wallpaper_to_be_deleted.handle != SLOT_HANDLE_INVALID)
     {
-        String name = texture_get_name(data.wallpaper_to_be_deleted);
         free(data.wallpaper_to_be_deleted);
-        free(name);
     }
 
     // Close windows
-    for (u64 i = 0; i < game_windows_to_be_closed.size; i++)
+    if (game_windows_to_be_closed.size > 0)
     {
-        remove(data.coroutine_handles, game_windows_to_be_closed[i]);
-        remove(data.active_game_windows, game_windows_to_be_closed[i]);
-        remove(data.game_window_positions, game_windows_to_be_closed[i]);
-        remove(data.game_window_ids, game_windows_to_be_closed[i]);
+        // Sorted so they can all be removed in one go
+        sort(game_windows_to_be_closed.data(), game_windows_to_be_closed.size);
+
+        for (u64 row : game_windows_to_be_closed)
+            remove(data.game_window_rows, game_window_handle(data, row));
+
+        remove_rows(data.game_windows, game_windows_to_be_closed.data(), game_windows_to_be_closed.size);
+        game_window_update_rows(data, game_windows_to_be_closed[0]);
     }
 
-    // Reorder windows
-    if (game_top_most_window_id != -1)
+    // Reorder windows, the window might have been closed this frame as well
+    if (const u64* row = find(data.game_window_rows, game_top_most_window))
     {
-        u64 index_to_move = data.active_game_windows.size;
-        GameWindowData window_data;
-
-        // Could optimize this maybe?
-        for (u64 i = 0; i < data.active_game_windows.size; i++)
-        {
-            if (data.game_window_ids[i] == game_top_most_window_id)
-            {
-                // Copy data to move
-                window_data.co = data.coroutine_handles[i];
-                window_data.callback = data.active_game_windows[i];
-                window_data.position = data.game_window_positions[i];
-                window_data.window_id = data.game_window_ids[i];
-
-                index_to_move = i;
-                break;
-            }
-        }
+        const u64 top_most_row = *row;
 
-        if (index_to_move != data.active_game_windows.size)
-        {
-            // Remove from original index
-            remove(data.coroutine_handles, index_to_move);
-            remove(data.active_game_windows, index_to_move);
-            remove(data.game_window_positions, index_to_move);
-            remove(data.game_window_ids, index_to_move);
-
-            // Append the data to the window arrays
-            append(data.coroutine_handles, window_data.co);
-            append(data.active_game_windows, window_data.callback);
-            append(data.game_window_positions, window_data.position);
-            append(data.game_window_ids, window_data.window_id);
-        }
+        move_to_back(data.game_windows, top_most_row);
+        game_window_update_rows(data, top_most_row);
     }
 
-    game_top_most_window_id = -1;
+    game_top_most_window = SLOT_HANDLE_INVALID;
     clear(game_windows_to_be_closed);
 }
 
 static inline void game_window_bring_to_front(GameData& data, u64 index)
 {
-    game_top_most_window_id = data.game_window_ids[index];
+    game_top_most_window = game_window_handle(data, index);
 }
 
 // Returns true if the X button was pressed
@@ -362,8 +355,8 @@ static bool game_window_render_background(const Imgui::Rect& window_rect, const
         {   // Window Border
             const Vector4 border_color_inactive = Vector4 { 0.45f, 0.45f, 0.45f, 1.0f };
 
-            const Vector4& border_color = (index == data.active_game_windows.size - 1) ? border_color_active : border_color_inactive;
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), border_rect, border_color, border_color, border_color))
+            const Vector4& border_color = (index == data.game_windows.size - 1) ? border_color_active : border_color_inactive;
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), border_rect, border_color, border_color, border_color))
                 game_window_bring_to_front(data, index);
         }
 
@@ -390,7 +383,7 @@ static bool game_window_render_background(const Imgui::Rect& window_rect, const
             const Vector4 button_color_hover   = Vector4 { 0.9f, 0.0f, 0.0f, 1.0f };
             const Vector4 button_color_pressed = Vector4 { 0.6f, 0.0f, 0.0f, 1.0f };
 
-            pressed_x_button = Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect, button_color_default, button_color_hover, button_color_pressed);
+            pressed_x_button = Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect, button_color_default, button_color_hover, button_color_pressed);
             if (pressed_x_button)
                 game_window_close(data, index);
 
@@ -450,7 +443,7 @@ static void game_window_render_background_fake(const Imgui::Rect& window_rect, c
 
 void game_window_main_loading_bar(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     bool& closed = coroutine_stack_variable<bool>(co);
 
@@ -509,7 +502,7 @@ void game_window_main_loading_bar(Coroutine& co, u64 index, Application& app, Ga
 
 void game_window_loading_finished(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     bool& closed = coroutine_stack_variable<bool>(co);
 
@@ -543,7 +536,7 @@ void game_window_loading_finished(Coroutine& co, u64 index, Application& app, Ga
                 rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
                 rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-                if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+                if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
                 {
                     game_window_close(data, index);
                     closed = true;
@@ -564,7 +557,7 @@ void game_window_loading_finished(Coroutine& co, u64 index, Application& app, Ga
 
 void game_window_project_already_open(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     bool& closed = coroutine_stack_variable<bool>(co);
 
@@ -597,7 +590,7 @@ void game_window_project_already_open(Coroutine& co, u64 index, Application& app
                 rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
                 rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-                if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+                if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
                 {
                     game_window_close(data, index);
                     closed = true;
@@ -618,7 +611,7 @@ void game_window_project_already_open(Coroutine& co, u64 index, Application& app
 
 void game_window_random_pop_up(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& offset = coroutine_stack_variable<Vector2>(co);
     f32& start_time  = coroutine_stack_variable<f32>(co);
@@ -640,7 +633,7 @@ void game_window_random_pop_up(Coroutine& co, u64 index, Application& app, GameD
 
     Imgui::Rect window_rect;
     window_rect.size = Vector2 { 300, 150 };
-    window_rect.top_left = Vector3 { data.game_window_positions[index].x + offset.x, data.game_window_positions[index].y + offset.y, -layer };
+    window_rect.top_left = Vector3 { game_window_position(data, index).x + offset.x, game_window_position(data, index).y + offset.y, -layer };
 
     bool closed = game_window_render_background(window_rect, ref("H0T $1NGL3S!"), data, index, data.border_color);
 
@@ -659,7 +652,7 @@ void game_window_random_pop_up(Coroutine& co, u64 index, Application& app, GameD
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect) && !closed)
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect) && !closed)
                 game_window_close(data, index);
 
             Imgui::render_text(text, data.ui_font, Vector3 { rect.top_left.x + game_padding_button_horizontal, rect.top_left.y + game_padding_button_vertical, rect.top_left.z - 0.001f }, game_font_size_button, Vector4 {0.0, 0.0f, 0.0f, 1.0f});
@@ -669,7 +662,7 @@ void game_window_random_pop_up(Coroutine& co, u64 index, Application& app, GameD
 
 void game_window_click_bait(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& offset = coroutine_stack_variable<Vector2>(co);
     f32& start_time = coroutine_stack_variable<f32>(co);
@@ -691,7 +684,7 @@ void game_window_click_bait(Coroutine& co, u64 index, Application& app, GameData
 
     Imgui::Rect window_rect;
     window_rect.size = Vector2 { 300, 150 };
-    window_rect.top_left = Vector3 { data.game_window_positions[index].x + offset.x, data.game_window_positions[index].y + offset.y, -layer };
+    window_rect.top_left = Vector3 { game_window_position(data, index).x + offset.x, game_window_position(data, index).y + offset.y, -layer };
 
     bool closed = game_window_render_background(window_rect, ref("New Offer Alerts!"), data, index, data.border_color);
 
@@ -710,7 +703,7 @@ void game_window_click_bait(Coroutine& co, u64 index, Application& app, GameData
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
             {
                 game_window_close(data, index);
 
@@ -729,7 +722,7 @@ void game_window_click_bait(Coroutine& co, u64 index, Application& app, GameData
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { game_padding_window_horizontal, window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect) && !closed)
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect) && !closed)
                 game_window_close(data, index);
 
             Imgui::render_text(text, data.ui_font, Vector3 { rect.top_left.x + game_padding_button_horizontal, rect.top_left.y + game_padding_button_vertical, rect.top_left.z - 0.001f }, game_font_size_button, Vector4 {0.0, 0.0f, 0.0f, 1.0f});
@@ -739,7 +732,7 @@ void game_window_click_bait(Coroutine& co, u64 index, Application& app, GameData
 
 void game_window_notification(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     f32& x_offset = coroutine_stack_variable<f32>(co);
     f32& t = coroutine_stack_variable<f32>(co);
@@ -781,7 +774,7 @@ void game_window_notification(Coroutine& co, u64 index, Application& app, GameDa
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
             {
                 game_window_close(data, index);
                 closed = false;
@@ -797,7 +790,7 @@ void game_window_notification(Coroutine& co, u64 index, Application& app, GameDa
 
 void game_window_baited(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& window_size_animated = coroutine_stack_variable<Vector2>(co);
     f32& t = coroutine_stack_variable<f32>(co);
@@ -882,7 +875,7 @@ void game_window_baited(Coroutine& co, u64 index, Application& app, GameData& da
 
 void game_window_shutdown(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& offset = coroutine_stack_variable<Vector2>(co);
     f32& start_time = coroutine_stack_variable<f32>(co);
@@ -923,7 +916,7 @@ void game_window_shutdown(Coroutine& co, u64 index, Application& app, GameData&
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { window_rect.size.x - (rect.size.x + game_padding_window_horizontal), window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
             {
                 game_window_close(data, index);
                 game_window_register(data, game_window_shutdown_loading_screen, Vector2 {});
@@ -940,7 +933,7 @@ void game_window_shutdown(Coroutine& co, u64 index, Application& app, GameData&
             rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
             rect.top_left = window_rect.top_left + Vector3 { game_padding_window_horizontal, window_rect.size.y - rect.size.y - game_padding_window_vertical, -0.001f };
 
-            if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect) && !closed)
+            if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect) && !closed)
                 game_window_close(data, index);
 
             Imgui::render_text(text, data.ui_font, Vector3 { rect.top_left.x + game_padding_button_horizontal, rect.top_left.y + game_padding_button_vertical, rect.top_left.z - 0.001f }, game_font_size_button, Vector4 {0.0, 0.0f, 0.0f, 1.0f});
@@ -950,7 +943,7 @@ void game_window_shutdown(Coroutine& co, u64 index, Application& app, GameData&
 
 void game_window_notes(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& window_size_animated = coroutine_stack_variable<Vector2>(co);
     f32& t = coroutine_stack_variable<f32>(co);
@@ -983,15 +976,15 @@ void game_window_notes(Coroutine& co, u64 index, Application& app, GameData& dat
     {
         {   // Body Text
             Vector3 top_left = window_rect.top_left + Vector3 { game_padding_window_horizontal, game_padding_window_vertical, -0.001f };
-            const String text = ref(notes_text, notes_text_size);
-            Imgui::render_text(text, data.ui_font, top_left, game_font_size_ui, Vector4 { 0.0f, 0.0f, 0.0f, 1.0f });
+            const f32 max_height = window_rect.size.y - 2.0f * game_padding_window_vertical;
+            Imgui::render_text(data.notes, data.ui_font, top_left, game_font_size_ui, Vector4 { 0.0f, 0.0f, 0.0f, 1.0f }, max_height);
         }
     }
 }
 
 void game_window_settings(Coroutine& co, u64 index, Application& app, GameData& data)
 {
-    f32 layer = (f32) index / (f32) data.active_game_windows.size;
+    f32 layer = (f32) index / (f32) data.game_windows.size;
 
     Vector2& window_size_animated = coroutine_stack_variable<Vector2>(co);
     f32& t = coroutine_stack_variable<f32>(co);
@@ -1086,7 +1079,7 @@ void game_window_settings(Coroutine& co, u64 index, Application& app, GameData&
                     rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
                     rect.top_left = window_rect.top_left + Vector3 { display_area_left - size.x - game_padding_window_horizontal - 2 * game_padding_button_horizontal, y, -0.001f };
 
-                    if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+                    if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
                     {
                         game_window_bring_to_front(data, index);
 
@@ -1095,11 +1088,9 @@ void game_window_settings(Coroutine& co, u64 index, Application& app, GameData&
                         if (platform_dialogue_open_file(filter, filename, 512))
                         {
                             // Delete temporary wallpaper only if it wasn't the desktop wallpaper
-                            if (wallpaper_selected.id != data.desktop_wallpaper.id)
+                            if (wallpaper_selected != data.desktop_wallpaper)
                             {
-                                String name = texture_get_name(wallpaper_selected);
                                 free(wallpaper_selected);
-                                free(name);
                             }
 
                             {   // Load new wallpaper
@@ -1111,7 +1102,7 @@ void game_window_settings(Coroutine& co, u64 index, Application& app, GameData&
                                 s32 width, height, bytes_pp;
                                 u8* pixels = stbi_load(filename, &width, &height, &bytes_pp, 4);
 
-                                wallpaper_selected = texture_load_pixels(make<String>((const char*) filename), pixels, width, height, 4, TextureSettings::default());
+                                wallpaper_selected = texture_load_pixels(ref(filename), pixels, width, height, 4, TextureSettings::default());
                                 wallpaper_dirty = true;
                             }
 
@@ -1225,7 +1216,7 @@ void game_window_settings(Coroutine& co, u64 index, Application& app, GameData&
                     rect.top_left = window_rect.top_left + Vector3 { display_area_left - size.x - game_padding_window_horizontal - 2 * game_padding_button_horizontal, y, -0.001f };
                     // rect.top_left = window_rect.top_left + Vector3 { x, y, -0.001f };
 
-                    if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+                    if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
                     {
                         game_window_bring_to_front(data, index);
 
@@ -1249,7 +1240,7 @@ void game_window_settings(Coroutine& co, u64 index, Application& app, GameData&
                 rect.size = size + Vector2 { 2 * game_padding_button_horizontal, 2 * game_padding_button_vertical };
                 rect.top_left = window_rect.top_left + Vector3 { game_padding_window_horizontal, y, -0.001f };
 
-                if (Imgui::render_button(gen_imgui_id_with_secondary(data.game_window_ids[index]), rect))
+                if (Imgui::render_button(gen_imgui_id_with_secondary(game_window_id(data, index)), rect))
                 {
                     game_window_bring_to_front(data, index);
 
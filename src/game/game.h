@@ -3,6 +3,8 @@
 #include "engine/imgui.h"
 #include "containers/bytes.h"
 #include "containers/darray.h"
+#include "containers/soa_table.h"
+#include "containers/slot_map.h"
 #include "containers/function.h"
 #include "core/coroutines.h"
 
@@ -11,6 +13,16 @@ struct GameData;
 using GameWindowRenderCallback = Function<void(Coroutine& co, u64 index, Application&, GameData&)>;
 using GameShortcutOpenCallback = Function<void(const Application&, GameData&)>;
 
+enum struct GameWindowColumn : u64
+{
+    COROUTINE,
+    RENDER_CALLBACK,
+    POSITION,
+    HANDLE,     // Stable across reordering, also used for Imgui IDs
+};
+
+using GameWindowTable = SoATable<Coroutine, GameWindowRenderCallback, Vector2, SlotHandle>;
+
 struct GameProjectDifficulty
 {
     f32 loading_speed_base;
@@ -43,11 +55,12 @@ struct GameData
     // Shortcuts
     DynamicArray<GameShortcut> shortcuts;
 
+    // Notes window text, editable so it's kept in a text buffer
+    TextBuffer notes;
+
     // Window Data
-    DynamicArray<Coroutine> coroutine_handles;
-    DynamicArray<GameWindowRenderCallback> active_game_windows;
-    DynamicArray<Vector2> game_window_positions;
-    DynamicArray<s32> game_window_ids;  // For Imgui
+    GameWindowTable game_windows;
+    SlotMap<u64> game_window_rows;  // Window handle to its current row in game_windows
 
     // Game Data
     bool started_game;
@@ -25,7 +25,7 @@ void game_load_assets(const Bytes& bytes, GameData& data)
         String name = Binary::get<String>(bytes, offset);
 
         Bytes pixels = Binary::get<Bytes>(bytes, offset);
-        data.shutdown_button_image = texture_load_pixels(copy(name), pixels.data, width, height, bytes_pp, TextureSettings::default());
+        data.shutdown_button_image = texture_load_pixels(name, pixels.data, width, height, bytes_pp, TextureSettings::default());
     }
 
     {   // Shortcut Icon Project
@@ -36,7 +36,7 @@ void game_load_assets(const Bytes& bytes, GameData& data)
         String name = Binary::get<String>(bytes, offset);
 
         Bytes pixels = Binary::get<Bytes>(bytes, offset);
-        data.shortcut_icon_project = texture_load_pixels(copy(name), pixels.data, width, height, bytes_pp, TextureSettings::default());
+        data.shortcut_icon_project = texture_load_pixels(name, pixels.data, width, height, bytes_pp, TextureSettings::default());
     }
     
     {   // Shortcut Icon Settings
@@ -47,7 +47,7 @@ void game_load_assets(const Bytes& bytes, GameData& data)
         String name = Binary::get<String>(bytes, offset);
 
         Bytes pixels = Binary::get<Bytes>(bytes, offset);
-        data.shortcut_icon_settings = texture_load_pixels(copy(name), pixels.data, width, height, bytes_pp, TextureSettings::default());
+        data.shortcut_icon_settings = texture_load_pixels(name, pixels.data, width, height, bytes_pp, TextureSettings::default());
     }
     
     {   // Shortcut Icon Notes
@@ -58,7 +58,7 @@ void game_load_assets(const Bytes& bytes, GameData& data)
         String name = Binary::get<String>(bytes, offset);
 
         Bytes pixels = Binary::get<Bytes>(bytes, offset);
-        data.shortcut_icon_notes = texture_load_pixels(copy(name), pixels.data, width, height, bytes_pp, TextureSettings::default());
+        data.shortcut_icon_notes = texture_load_pixels(name, pixels.data, width, height, bytes_pp, TextureSettings::default());
     }
 
     gn_assert_with_message(offset == bytes.size - 1, "For some reason there's extra data in the settings bytes! (file size: %, stopped parsing at: %)", bytes.size, offset);
@@ -89,7 +89,7 @@ void game_load_settings(const Bytes& bytes, Application& app, GameData& data)
 
         Bytes pixels = Binary::get<Bytes>(bytes, offset);
 
-        data.desktop_wallpaper = texture_load_pixels(copy(name), pixels.data, width, height, bytes_pp, TextureSettings::default());
+        data.desktop_wallpaper = texture_load_pixels(name, pixels.data, width, height, bytes_pp, TextureSettings::default());
 
         data.wallpaper_pixels = (u8*) platform_reallocate(data.wallpaper_pixels, width * height * bytes_pp);
         gn_assert_with_message(data.wallpaper_pixels, "Couldn't reallocate data for storing wallpaper pixels");
@@ -6,6 +6,7 @@
 #include "containers/darray.h"
 #include "containers/string.h"
 #include "containers/string_builder.h"
+#include "containers/virtual_array.h"
 #include "platform/platform.h"
 #include "serialization/binary.h"
 #include "fileio/fileio.h"
@@ -17,15 +18,16 @@
 namespace Package
 {
 
-Bytes pack_assets()
+VirtualArray<u8> pack_assets()
 {
-    constexpr u64 GB = 1 * 1024 * 1024 * 1024;
-    DynamicArray<u8> bytes = make<DynamicArray<u8>>(GB);
+    // Only the pages that get written to are committed, so this can be generous
+    constexpr u64 max_package_size = 16ull * 1024 * 1024 * 1024;
+    VirtualArray<u8> bytes = make<VirtualArray<u8>>(max_package_size);
 
     append(bytes, Binary::OBJECT_START);
 
     {   // Font
-        Bytes font_bytes = file_load_bytes(ref("assets/fonts/assistant-medium.font.bytes"));
+        Bytes font_bytes = file_load_bytes(view("assets/fonts/assistant-medium.font.bytes"));
         Binary::append_bytes(bytes, font_bytes.data, font_bytes.size);
         free(font_bytes);
     }
@@ -77,16 +79,13 @@ Bytes pack_assets()
     }
 
     append(bytes, Binary::OBJECT_END);
-    
-    if (bytes.size != bytes.capacity)
-        resize(bytes, bytes.size);  // Shrink the array to free extra memory
 
-    return Bytes { bytes.data, bytes.size };
+    return bytes;
 }
 
 Bytes pack_settings(const Application& app, const GameData& data)
 {
-    DynamicArray<u8> bytes = make<DynamicArray<u8>>(2048Ui64);
+    DynamicArray<u8> bytes = make<DynamicArray<u8>>(2048ull);
 
     append(bytes, Binary::OBJECT_START);
 
@@ -123,7 +122,7 @@ Bytes pack_settings(const Application& app, const GameData& data)
 
 Bytes pack_settings_default(const GameData& data)
 {
-    DynamicArray<u8> bytes = make<DynamicArray<u8>>(2048Ui64);
+    DynamicArray<u8> bytes = make<DynamicArray<u8>>(2048ull);
 
     append(bytes, Binary::OBJECT_START);
 
@@ -160,9 +159,9 @@ Bytes pack_settings_default(const GameData& data)
     return Bytes { bytes.data, bytes.size };
 }
 
-static inline String string_escape_and_copy(const String source)
+static inline void append_escaped(StringBuilder& builder, const String source)
 {
-    DynamicArray<char> result = make<DynamicArray<char>>(source.size);
+    reserve(builder, source.size);
 
     for (u64 i = 0; i < source.size; i++)
     {
@@ -172,13 +171,12 @@ static inline String string_escape_and_copy(const String source)
         {
             case '\n':
             {
-                append(result, '\\');
-                append(result, 'n');
+                append(builder, "\\n");
             } break;
             
             case '\t':
             {
-                append(result, ' ');    // No need for tabs when packing
+                append(builder, ' ');   // No need for tabs when packing
             } break;
 
             // These can be skipped
@@ -188,55 +186,35 @@ static inline String string_escape_and_copy(const String source)
 
             default:
             {
-                append(result, ch);
+                append(builder, ch);
             } break;
         }
     }
-
-    // No need to resize cause it's just used for packing
-
-    return String { result.data, result.size };
 }
 
-static inline void pack_shader(String shader_name, String shader_path,
-                               DynamicArray<String>& builder, DynamicArray<String>& strings_to_be_freed)
+static inline void pack_shader(const char* shader_name, String shader_path, StringBuilder& builder)
 {
-    append(builder, ref("constexpr char* "));
-    append(builder, shader_name);
-    append(builder, ref(" = \""));
+    append_format(builder, "constexpr char* % = \"", shader_name);
 
-    String source_raw = file_load_string(shader_path);
-    String source_escaped = string_escape_and_copy(source_raw);
-
-    append(builder, source_escaped);
-
-    append(strings_to_be_freed, source_escaped);
+    String source_raw = file_load_string(view(shader_path));
+    append_escaped(builder, source_raw);
     free(source_raw);
     
-    append(builder, ref("\";\n"));
+    append(builder, "\";\n");
 }
 
 String pack_shaders()
 {
-    DynamicArray<String> builder = make<DynamicArray<String>>();
-    DynamicArray<String> strings_to_be_freed = make<DynamicArray<String>>();
-
-    append(builder, ref("#pragma once\n\n"));
+    StringBuilder builder = make<StringBuilder>(4096ull);
 
-    pack_shader(ref("ui_quad_vert_shader_source"), ref(ui_quad_vert_shader_path), builder, strings_to_be_freed);
-    pack_shader(ref("ui_quad_frag_shader_source"), ref(ui_quad_frag_shader_path), builder, strings_to_be_freed);
-    pack_shader(ref("ui_font_vert_shader_source"), ref(ui_font_vert_shader_path), builder, strings_to_be_freed);
-    pack_shader(ref("ui_font_frag_shader_source"), ref(ui_font_frag_shader_path), builder, strings_to_be_freed);
+    append(builder, "#pragma once\n\n");
 
-    String final = build_string(builder);
-    
-    for (u64 i = 0; i < strings_to_be_freed.size; i++)
-        free(strings_to_be_freed[i]);
-    
-    free(strings_to_be_freed);
-    free(builder);
+    pack_shader("ui_quad_vert_shader_source", ref(ui_quad_vert_shader_path), builder);
+    pack_shader("ui_quad_frag_shader_source", ref(ui_quad_frag_shader_path), builder);
+    pack_shader("ui_font_vert_shader_source", ref(ui_font_vert_shader_path), builder);
+    pack_shader("ui_font_frag_shader_source", ref(ui_font_frag_shader_path), builder);
 
-    return final;
+    return finish(builder);
 }
 
 }
\ No newline at end of file
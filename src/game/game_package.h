@@ -3,6 +3,7 @@
 #include "core/types.h"
 #include "containers/bytes.h"
 #include "containers/darray.h"
+#include "containers/virtual_array.h"
 
 #include "application/application.h"
 #include "game.h"
@@ -10,7 +11,7 @@
 namespace Package
 {
 
-Bytes pack_assets();
+VirtualArray<u8> pack_assets();      // Free with free(), not as Bytes
 Bytes pack_settings(const Application& app, const GameData& data);
 Bytes pack_settings_default(const GameData& data);
 String pack_shaders();
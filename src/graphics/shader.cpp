@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include "containers/string.h"
+#include "containers/string_view.h"
 #include "containers/hash_table.h"
 #include "math/mats/matrix4.h"
 #include "core/logger.h"
@@ -9,22 +10,24 @@
 
 #include <glad/glad.h>
 
-bool shader_compile_from_file(Shader& shader, const String filepath, Shader::Type type)
+bool shader_compile_from_file(Shader& shader, const StringView filepath, Shader::Type type)
 {
     String source = file_load_string(filepath);
-    bool result = shader_compile_source(shader, source, type);
+    bool result = shader_compile_source(shader, view(source), type);
     free(source);
 
     return result;
 }
 
-bool shader_compile_source(Shader& shader, const String source, Shader::Type type)
+bool shader_compile_source(Shader& shader, const StringView source, Shader::Type type)
 {
     // Since I just know fragment and vertex shaders, this works lol
     GLenum gl_shader_type = GL_FRAGMENT_SHADER + (int) type;
     u32 id = glCreateShader(gl_shader_type);
 
-    glShaderSource(id, 1, &(source.data), nullptr);
+    // Passing the length means the source doesn't have to be null terminated
+    const GLint source_length = (GLint) source.size;
+    glShaderSource(id, 1, &(source.data), &source_length);
     glCompileShader(id);
 
 #ifdef GN_DEBUG
@@ -37,7 +40,7 @@ bool shader_compile_source(Shader& shader, const String source, Shader::Type typ
         GLchar message[1024];
 
         glGetShaderInfoLog(id, 1024, &log_length, message);
-        print("Shader Error: %\n", ref(message, log_length));
+        print("Shader Error: %\n", view(message, (u64) log_length));
 
         return false;
     }
@@ -65,7 +68,7 @@ bool shader_link(Shader& shader)
         GLchar message[1024];
 
         glGetProgramInfoLog(shader.program, 1024, &log_length, message);
-        print("Shader Error: %\n", ref(message, log_length));
+        print("Shader Error: %\n", view(message, (u64) log_length));
 
         return false;
     }
@@ -74,7 +77,7 @@ bool shader_link(Shader& shader)
     glDeleteShader(shader.ids[0]);
     glDeleteShader(shader.ids[1]);
 
-    shader.uniforms = make<HashTable<String, s32>>();
+    shader.uniforms = make<HashTable<Atom, s32>>();
 
     return true;
 }
@@ -84,70 +87,71 @@ void shader_bind(const Shader& shader)
     glUseProgram(shader.program);
 }
 
-static inline s32 get_uniform_location(Shader& shader, String uniform_name)
+static inline s32 get_uniform_location(Shader& shader, const Atom uniform_name)
 {
     auto elem = find(shader.uniforms, uniform_name);
     if (elem)
         return elem.value();
 
-    s32 uniform_location = glGetUniformLocation(shader.program, uniform_name.data);
+    // Interned strings are null terminated
+    s32 uniform_location = glGetUniformLocation(shader.program, atom_string(uniform_name).data);
     gn_assert_with_message(uniform_location >= 0, "Uniform not found in shader! (name: %)", uniform_name);
 
     put(shader.uniforms, uniform_name, uniform_location);
     return uniform_location;
 }
 
-void shader_set_uniform_1i(Shader& shader, String uniform_name, s32 v0)
+void shader_set_uniform_1i(Shader& shader, const Atom uniform_name, s32 v0)
 {
     glUniform1i(get_uniform_location(shader, uniform_name), v0);
 }
 
-void shader_set_uniform_1iv(Shader& shader, String uniform_name, u32 count, s32* vs)
+void shader_set_uniform_1iv(Shader& shader, const Atom uniform_name, u32 count, s32* vs)
 {
     glUniform1iv(get_uniform_location(shader, uniform_name), count, vs);
 }
 
-void shader_set_uniform_1f(Shader& shader, String uniform_name, f32 v0)
+void shader_set_uniform_1f(Shader& shader, const Atom uniform_name, f32 v0)
 {
     glUniform1f(get_uniform_location(shader, uniform_name), v0);
 }
 
-void shader_set_uniform_1fv(Shader& shader, String uniform_name, u32 count, f32* vs)
+void shader_set_uniform_1fv(Shader& shader, const Atom uniform_name, u32 count, f32* vs)
 {
     glUniform1fv(get_uniform_location(shader, uniform_name), count, vs);
 }
 
-void shader_set_uniform_2f(Shader& shader, String uniform_name, f32 v0, f32 v1)
+void shader_set_uniform_2f(Shader& shader, const Atom uniform_name, f32 v0, f32 v1)
 {
     glUniform2f(get_uniform_location(shader, uniform_name), v0, v1);
 }
 
-void shader_set_uniform_2fv(Shader& shader, String uniform_name, u32 count, f32* vs)
+void shader_set_uniform_2fv(Shader& shader, const Atom uniform_name, u32 count, f32* vs)
 {
     glUniform2fv(get_uniform_location(shader, uniform_name), count, vs);
 }
 
-void shader_set_uniform_3f(Shader& shader, String uniform_name, f32 v0, f32 v1, f32 v2)
+void shader_set_uniform_3f(Shader& shader, const Atom uniform_name, f32 v0, f32 v1, f32 v2)
 {
     glUniform3f(get_uniform_location(shader, uniform_name), v0, v1, v2);
 }
 
-void shader_set_uniform_3fv(Shader& shader, String uniform_name, u32 count, f32* vs)
+void shader_set_uniform_3fv(Shader& shader, const Atom uniform_name, u32 count, f32* vs)
 {
     glUniform3fv(get_uniform_location(shader, uniform_name), count, vs);
 }
 
-void shader_set_uniform_4f(Shader& shader, String uniform_name, f32 v0, f32 v1, f32 v2, f32 v3)
+void shader_set_uniform_4f(Shader& shader, const Atom uniform_name, f32 v0, f32 v1, f32 v2, f32 v3)
 {
     glUniform4f(get_uniform_location(shader, uniform_name), v0, v1, v2, v3);
 }
 
-void shader_set_uniform_4fv(Shader& shader, String uniform_name, u32 count, f32* vs)
+void shader_set_uniform_4fv(Shader& shader, const Atom uniform_name, u32 count, f32* vs)
 {
     glUniform4fv(get_uniform_location(shader, uniform_name), count, vs);
 }
 
-void shader_set_uniform_mat4(Shader& shader, String uniform_name, const Matrix4& mat)
+void shader_set_uniform_mat4(Shader& shader, const Atom uniform_name, const Matrix4& mat)
 {
     glUniformMatrix4fv(get_uniform_location(shader, uniform_name), 1, false, (f32*) mat.data);
 }
\ No newline at end of file
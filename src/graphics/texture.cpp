@@ -2,30 +2,49 @@
 
 #include "core/types.h"
 #include "containers/string.h"
-#include "containers/hash_table.h"
+#include "containers/concurrent_hash_table.h"
+#include "core/atom.h"
+#include "core/memory_tracker.h"
 
+#include <atomic>
 #include <stb_image.h>
 #include <glad/glad.h>
 
-static HashTable<String, Texture> loaded_textures = make<HashTable<String, Texture>>();
+// Keyed on interned names so lookups are integer compares.
+// Sharded so loaders on other threads can query it without a global lock.
+// Loading on another thread also needs a GL context that's current on that thread.
+static ConcurrentHashTable<Atom, Texture> loaded_textures = make<ConcurrentHashTable<Atom, Texture>>();
 
-// OpenGL generates textureIDs sequentially so
-// this way extra data about the texture can be accessed
-// by using them as an index into an array rather than
-// copying them everywhere.
+// Everything about a texture lives in the registry and the
+// texture itself is only a handle, so handles to freed textures
+// can be caught instead of reading another texture's data.
 
 struct TextureData
 {
+    u32 gl_id;
     s32 width, height, bytes_pp;
-    String name;
+    Atom name;
 };
 
-constexpr u32 max_loaded_textures = 10;
-static TextureData texture_data_table[max_loaded_textures] = {};
+// Keyed on the handle and sharded the same way as loaded_textures, so looking
+// up a texture doesn't wait on loads or lookups of textures in other shards.
+// Handles come from a counter and are never reused, which is what makes stale ones fail to find anything.
+static ConcurrentHashTable<u64, TextureData> texture_registry = make<ConcurrentHashTable<u64, TextureData>>();
+static std::atomic<u32> texture_next_handle;
 
-static inline Texture internal_load_pixels(const String name, u8* pixels, s32 width, s32 height, s32 bytes_pp, const TextureSettings& settings)
+// Copied out since another thread can change the registry right after
+static inline TextureData texture_get_data(const Texture& texture)
 {
-    Texture texture;
+    TextureData data;
+    const bool found = find(texture_registry, (u64) texture.handle.value, data);
+    gn_assert_with_message(found, "Texture handle is stale or was never loaded! (handle: %)", texture.handle.value);
+
+    return data;
+}
+
+static inline Texture internal_load_pixels(const Atom name, u8* pixels, s32 width, s32 height, s32 bytes_pp, const TextureSettings& settings)
+{
+    TextureData data;
 
     GLint internal_format, format;
     switch (bytes_pp)
@@ -49,8 +68,8 @@ static inline Texture internal_load_pixels(const String name, u8* pixels, s32 wi
     }
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glGenTextures(1, &texture.id);
-    glBindTexture(GL_TEXTURE_2D, texture.id);
+    glGenTextures(1, &data.gl_id);
+    glBindTexture(GL_TEXTURE_2D, data.gl_id);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
     glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -59,28 +78,66 @@ static inline Texture internal_load_pixels(const String name, u8* pixels, s32 wi
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint) settings.wrap_s);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint) settings.wrap_t);
 
-    texture_data_table[texture.id].width    = width;
-    texture_data_table[texture.id].height   = height;
-    texture_data_table[texture.id].bytes_pp = bytes_pp;
-    texture_data_table[texture.id].name     = name;
+    data.width    = width;
+    data.height   = height;
+    data.bytes_pp = bytes_pp;
+    data.name     = name;
 
-    return texture;
+    // The heap never sees GPU memory so it's counted by hand, mipmaps not included
+    memory_tracker_record_allocation(MemoryTag::TEXTURES, (u64) width * height * bytes_pp);
+
+    // Starts at 1 so SLOT_HANDLE_INVALID is never handed out
+    const SlotHandle handle = SlotHandle { texture_next_handle.fetch_add(1, std::memory_order_relaxed) + 1 };
+    put(texture_registry, (u64) handle.value, data);
+
+    return Texture { handle };
+}
+
+// Only gets rid of the GPU side and the registry entry, the name is left in loaded_textures
+static inline bool internal_free(const Texture& texture, Atom& out_name)
+{
+    // Only the thread that gets to remove it deletes it, in case it's freed twice at once
+    TextureData data;
+    if (!find(texture_registry, (u64) texture.handle.value, data) || !remove(texture_registry, (u64) texture.handle.value))
+        return false;
+
+    glDeleteTextures(1, &data.gl_id);
+    memory_tracker_record_free(MemoryTag::TEXTURES, (u64) data.width * data.height * data.bytes_pp);
+
+    out_name = data.name;
+    return true;
+}
+
+// Two threads can load the same name at once, whichever got into the table first wins and the other copy is dropped
+static inline Texture internal_register(const Atom name, const Texture texture)
+{
+    const Texture winner = put(loaded_textures, name, texture);
+    if (winner != texture)
+    {
+        Atom unused_name;
+        internal_free(texture, unused_name);
+    }
+
+    return winner;
 }
 
 Texture texture_load_file(const String filepath, const TextureSettings& settings)
 {
     stbi_set_flip_vertically_on_load(true);
 
-    auto tex = find(loaded_textures, filepath);
-    if (tex)
-        return tex.value();
+    const Atom name = atom_intern(filepath);
+
+    Texture texture;
+    if (find(loaded_textures, name, texture))
+        return texture;
     
     s32 width, height, bytes_pp;
     u8* pixels = stbi_load(filepath.data, &width, &height, &bytes_pp, 0);
     gn_assert_with_message(pixels, "Couldn't load image data! (filepath: \"%\")", filepath);
 
-    Texture texture = internal_load_pixels(filepath, pixels, width, height, bytes_pp, settings);
-    put(loaded_textures, filepath, texture);
+    memory_tracker_push_tag(MemoryTag::TEXTURES);
+    texture = internal_register(name, internal_load_pixels(name, pixels, width, height, bytes_pp, settings));
+    memory_tracker_pop_tag();
 
     stbi_image_free(pixels);
     return texture;
@@ -88,27 +145,29 @@ Texture texture_load_file(const String filepath, const TextureSettings& settings
 
 Texture texture_load_pixels(const String name, u8* pixels, s32 width, s32 height, s32 bytes_pp, const TextureSettings& settings)
 {
-    auto tex = find(loaded_textures, name);
-    if (tex)
-        return tex.value();
+    const Atom name_atom = atom_intern(name);
 
-    Texture texture = internal_load_pixels(name, pixels, width, height, bytes_pp, settings);
-    put(loaded_textures, name, texture);    
+    Texture texture;
+    if (find(loaded_textures, name_atom, texture))
+        return texture;
+
+    memory_tracker_push_tag(MemoryTag::TEXTURES);
+    texture = internal_register(name_atom, internal_load_pixels(name_atom, pixels, width, height, bytes_pp, settings));
+    memory_tracker_pop_tag();
 
     return texture;
 }
 
 void free(Texture& texture)
 {
-    if (texture.id)
+    Atom name;
+    if (internal_free(texture, name))
     {
-        auto elem = find(loaded_textures, texture_data_table[texture.id].name);
-        gn_assert_with_message((bool) elem, "Texture id is not 0 but hasn't been loaded properly!");
-        remove(elem);
-
-        glDeleteTextures(1, &texture.id);
-        texture.id = 0;
+        const bool removed = remove(loaded_textures, name);
+        gn_assert_with_message(removed, "Texture handle is valid but hasn't been loaded properly!");
     }
+
+    texture.handle = SLOT_HANDLE_INVALID;
 }
 
 // Assuming there are 32 texture slots in the GPU
@@ -116,42 +175,39 @@ static u32 bound_textures[32] = {};
 
 void texture_bind(const Texture& texture, s32 slot)
 {
+    const u32 gl_id = texture_get_data(texture).gl_id;
+
     // Only bind if the texture wasn't bound before
-    if (bound_textures[slot] != texture.id)
+    if (bound_textures[slot] != gl_id)
     {
         glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, texture.id);
+        glBindTexture(GL_TEXTURE_2D, gl_id);
         
-        bound_textures[slot] = texture.id;
+        bound_textures[slot] = gl_id;
     }
 }
 
 s32 texture_get_width(const Texture& texture)
 {
-    return texture_data_table[texture.id].width;
+    return texture_get_data(texture).width;
 }
 
 s32 texture_get_height(const Texture& texture)
 {
-    return texture_data_table[texture.id].height;
+    return texture_get_data(texture).height;
 }
 
 s32 texture_get_bytes_pp(const Texture& texture)
 {
-    return texture_data_table[texture.id].bytes_pp;
+    return texture_get_data(texture).bytes_pp;
 }
 
 const String texture_get_name(const Texture& texture)
 {
-    return texture_data_table[texture.id].name;
+    return atom_string(texture_get_data(texture).name);
 }
 
 bool texture_get_existing(const String name, Texture& out_texture)
 {
-    auto tex = find(loaded_textures, name);
-    if (!tex)
-        return false;
-
-    out_texture = tex.value();
-    return true;
+    return find(loaded_textures, atom_find(name), out_texture);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include "containers/string.h"
+#include "containers/slot_map.h"
 
 #include <glad/glad.h>
 
@@ -31,11 +32,22 @@ struct TextureSettings
     static TextureSettings default() { return TextureSettings(); }
 };
 
+// Handle into the texture registry, goes stale once the texture is freed
 struct Texture
 {
-    u32 id;
+    SlotHandle handle;
 };
 
+inline bool operator==(const Texture& a, const Texture& b)
+{
+    return a.handle == b.handle;
+}
+
+inline bool operator!=(const Texture& a, const Texture& b)
+{
+    return a.handle != b.handle;
+}
+
 Texture texture_load_file(const String filepath, const TextureSettings& settings);
 Texture texture_load_pixels(const String name, u8* pixels, s32 width, s32 height, s32 bytes_pp, const TextureSettings& settings);
 void free(Texture& texture);
@@ -45,6 +57,7 @@ void texture_bind(const Texture& texture, s32 slot);
 s32 texture_get_width(const Texture& texture);
 s32 texture_get_height(const Texture& texture);
 s32 texture_get_bytes_pp(const Texture& texture);
+// Names are interned, the returned string shouldn't be freed
 const String texture_get_name(const Texture& texture);
 
 bool texture_get_existing(const String name, Texture& out_texture);
\ No newline at end of file
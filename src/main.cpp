@@ -8,6 +8,9 @@
 #include "game/game.h"
 #include "math/common.h"
 #include "graphics/texture.h"
+#include "core/linear_arena.h"
+#include "core/memory_tracker.h"
+#include "containers/string_builder.h"
 
 #include "game/game_package.h"
 #include "game/game_loader.h"
@@ -21,10 +24,10 @@ void init(Application& app)
     // Note: Used when packaging data for build
 
     // {   // Pack Assets
-    //     Bytes bytes = Package::pack_assets();
-    //     Bytes compressed = compress_bytes(bytes);
+    //     VirtualArray<u8> bytes = Package::pack_assets();
+    //     Bytes compressed = compress_bytes(Bytes { bytes.data, bytes.size });
 
-    //     file_write_bytes(ref("package.bytes"), compressed);
+    //     file_write_bytes(view("package.bytes"), compressed);
 
     //     free(compressed);
     //     free(bytes);
@@ -34,7 +37,7 @@ void init(Application& app)
     //     Bytes bytes = Package::pack_settings_default(app, data);
     //     Bytes compressed = compress_bytes(bytes);
 
-    //     file_write_bytes(ref("settings.bytes"), compressed);
+    //     file_write_bytes(view("settings.bytes"), compressed);
 
     //     free(compressed);
     //     free(bytes);
@@ -42,12 +45,14 @@ void init(Application& app)
 
     // {   // Pack Shaders
     //     String contents = Package::pack_shaders();
-    //     file_write_string(ref("src/engine/packed_shaders.h"), contents);
+    //     file_write_string(view("src/engine/packed_shaders.h"), view(contents));
     //     free(contents);
     // }
     
+    memory_tracker_push_tag(MemoryTag::PACKAGE);
+
     {   // Load Assets
-        Bytes bytes = file_load_bytes(ref("package.bytes"));
+        Bytes bytes = file_load_bytes(view("package.bytes"));
         Bytes uncompressed = decompress_bytes(bytes);
         
         game_load_assets(uncompressed, data);
@@ -57,7 +62,7 @@ void init(Application& app)
     }
 
     {   // Load settings
-        Bytes bytes = file_load_bytes(ref("settings.bytes"));
+        Bytes bytes = file_load_bytes(view("settings.bytes"));
         Bytes uncompressed = decompress_bytes(bytes);
 
         game_load_settings(uncompressed, app, data);
@@ -66,6 +71,8 @@ void init(Application& app)
         free(bytes);
     }
 
+    memory_tracker_pop_tag();
+
     // Setup Game
     game_init(app, data);
 }
@@ -82,28 +89,32 @@ void update(Application& app)
 
     if (data.save_settings)
     {
+        memory_tracker_push_tag(MemoryTag::PACKAGE);
+
         Bytes bytes = Package::pack_settings(app, data);
         Bytes compressed = compress_bytes(bytes);
 
-        file_write_bytes(ref("settings.bytes"), compressed);
+        file_write_bytes(view("settings.bytes"), compressed);
 
         free(compressed);
         free(bytes);
 
+        memory_tracker_pop_tag();
+
         data.save_settings = false;
     }
 
     if (data.initial_loading)
         return;
 
-    if (data.active_game_windows.size > 0)
+    if (data.game_windows.size > 0)
     {
         f32 load_speed = data.current_project_difficulty.loading_speed_base;
 
         if (sqr_length(Input::mouse_delta_position()) >= 0.001f)
             load_speed *= 0.5f;
 
-        load_speed *= 1.0f / (data.active_game_windows.size * data.active_game_windows.size);
+        load_speed *= 1.0f / (data.game_windows.size * data.game_windows.size);
 
 #ifdef GN_DEBUG
         data.load_speed_multiplier = load_speed / data.current_project_difficulty.loading_speed_base;
@@ -176,10 +187,24 @@ void render(Application& app)
 #ifdef GN_DEBUG
     if (data.is_debug)
     {
-        char buffer[128];
-        sprintf(buffer, "Active windows: %llu\nLoading Speed: %.3f", data.active_game_windows.size, data.load_speed_multiplier);
+        // Lives in the frame arena so it doesn't show up in the allocation count
+        StringBuilder builder = make<StringBuilder>(128ull, frame_allocator());
+        append_format(builder, "Active windows: %\nLoading Speed: %\nAllocations last frame: %\nFrame arena peak: % KB",
+                      data.game_windows.size, data.load_speed_multiplier, app.frame_allocation_count, frame_arena().peak / 1024);
+        append_format(builder, "\nFrame time: % ms (p99 % ms, max % ms)",
+                      app.frame_times.p50 * 1000.0f, app.frame_times.p99 * 1000.0f, app.frame_times.max * 1000.0f);
+
+        if (memory_tracker_enabled)
+        {
+            for (u32 i = 0; i < (u32) MemoryTag::NUM_TAGS; i++)
+            {
+                const MemoryTagStats stats = memory_tracker_get_stats((MemoryTag) i);
+                append_format(builder, "\n%: % KB (peak % KB, % last frame)",
+                              memory_tag_name((MemoryTag) i), stats.live_bytes / 1024, stats.peak_bytes / 1024, stats.frame_allocations);
+            }
+        }
 
-        String text = ref(buffer);
+        String text = ref(builder);
         Vector2 size = Imgui::get_rendered_text_size(text, data.ui_font, 25.0f);
         
         constexpr f32 padding = 5.0f;
@@ -87,7 +87,11 @@ f32 almost_equals(f32 a, f32 b, f32 epsilon = 0.001f)
 GN_DISABLE_SECURITY_COOKIE_CHECK GN_FORCE_INLINE
 f32 sign(f32 t)
 {
+#if defined(GN_COMPILER_MSVC)
     return __signbitvaluef(t);
+#else
+    return __builtin_signbitf(t);
+#endif
 }
 
 GN_DISABLE_SECURITY_COOKIE_CHECK GN_FORCE_INLINE
@@ -140,6 +144,22 @@ f32 sqrt(f32 x)
 
 // Extra Functions
 
+// Smallest power of 2 that is >= x (returns 1 for 0)
+GN_DISABLE_SECURITY_COOKIE_CHECK GN_FORCE_INLINE
+u32 next_power_of_2(u32 x)
+{
+    if (x <= 1)
+        return 1;
+
+    x--;
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    return x + 1;
+}
+
 // Gives a random float in the range [0, 1)
 GN_DISABLE_SECURITY_COOKIE_CHECK GN_FORCE_INLINE
 f32 random()
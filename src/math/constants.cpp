@@ -1,5 +1,3 @@
-#pragma once
-
 // Linear Algebra Constants
 
 #include "vecs/vector3.h"
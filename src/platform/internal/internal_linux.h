@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef GN_PLATFORM_LINUX
+
+#include "core/types.h"
+
+// Headless, so there's no actual window. Only what the window would have been is kept around.
+struct InternalState
+{
+    s32 x, y;
+    s32 width, height;
+};
+
+#endif // GN_PLATFORM_LINUX
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifdef GN_TRACK_MEMORY
+
+#include "core/types.h"
+#include "core/memory_tracker.h"
+
+// With memory tracking on, every heap block gets a header right in front of
+// it so frees and reallocations know how big the block was and which tag
+// it was counted under. The block itself keeps the alignment it asked for.
+
+struct alignas(16) TrackedBlockHeader
+{
+    u64 size;
+    u32 offset;     // From the start of the actual allocation to the block
+    MemoryTag tag;
+};
+
+// Extra bytes to allocate in front of a block with this alignment
+inline u64 tracked_block_offset(u64 alignment)
+{
+    return (alignment > sizeof(TrackedBlockHeader)) ? alignment : sizeof(TrackedBlockHeader);
+}
+
+inline TrackedBlockHeader* tracked_block_header(void* block)
+{
+    return (TrackedBlockHeader*) ((u8*) block - sizeof(TrackedBlockHeader));
+}
+
+inline void* tracked_block_allocation(void* block)
+{
+    return (u8*) block - tracked_block_header(block)->offset;
+}
+
+// Takes a fresh allocation and returns the block inside it, null allocations stay null
+inline void* tracked_block_begin(void* allocation, u64 offset, u64 size, MemoryTag tag)
+{
+    if (!allocation)
+        return nullptr;
+
+    void* block = (u8*) allocation + offset;
+
+    TrackedBlockHeader* header = tracked_block_header(block);
+    header->size   = size;
+    header->offset = (u32) offset;
+    header->tag    = tag;
+
+    memory_tracker_record_allocation(tag, size);
+
+    return block;
+}
+
+// Call before the allocation is freed or reallocated, returns the allocation
+inline void* tracked_block_end(void* block)
+{
+    TrackedBlockHeader* header = tracked_block_header(block);
+    memory_tracker_record_free(header->tag, header->size);
+
+    return tracked_block_allocation(block);
+}
+
+#endif // GN_TRACK_MEMORY
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include "core/types.h"
 
 struct InternalState;   // Defined based on the OS
@@ -21,16 +22,32 @@ void platform_set_window_style(WindowStyle style);
 
 // Memory Stuff
 
-void* platform_allocate(u64 size);                   // TODO: Option for aligned memory
-void* platform_reallocate(void* block, u64 size);    // TODO: Option for aligned memory
-void  platform_free(void* block);                    // TODO: Option for aligned memory
+void* platform_allocate(u64 size);                  // Blocks are 16 byte aligned
+void* platform_reallocate(void* block, u64 size);
+void  platform_free(void* block);
+
+// Alignment has to be a power of 2. Blocks from these can only be reallocated and freed with the aligned versions.
+void* platform_allocate_aligned(u64 size, u64 alignment);
+void* platform_reallocate_aligned(void* block, u64 size, u64 alignment);
+void  platform_free_aligned(void* block);
+
+u64 platform_get_allocation_count();    // Calls to allocate and reallocate so far, always 0 in release builds
 
 void* platform_zero_memory(void* block, u64 size);
 void* platform_copy_memory(void* dest, const void* source, u64 size);
+void* platform_move_memory(void* dest, const void* source, u64 size);     // Memory regions can overlap
 void* platform_set_memory(void* dest, s32 value, u64 size);
 
 bool platform_compare_memory(const void* ptr1, const void* ptr2, u64 size);
 
+// Reserving only claims address space, pages have to be committed before they're used.
+// Addresses and sizes given to these have to be page aligned.
+u64   platform_get_page_size();
+void* platform_reserve_memory(u64 size);
+bool  platform_commit_memory(void* address, u64 size);
+void  platform_decommit_memory(void* address, u64 size);     // Pages stay reserved and can be committed again
+void  platform_release_memory(void* address, u64 size);      // Size is the whole reserved size
+
 // Time Stuff
 
 void platform_init_clock();
@@ -44,4 +61,67 @@ void platform_show_mouse_cursor(bool value);
 
 // File Stuff
 
-bool platform_dialogue_open_file(const char filter[], char* out_filepath, u32 max_path_size);
\ No newline at end of file
+bool platform_dialogue_open_file(const char filter[], char* out_filepath, u32 max_path_size);
+
+// Thread Stuff
+
+typedef void (*PlatformThreadProc)(void* data);
+
+struct PlatformThread
+{
+    u64 handle;     // HANDLE on Windows, pthread_t on Linux
+};
+
+// Sync objects hold the platform's own type in place so they never need to be
+// allocated. They can't be moved or copied between create and destroy.
+
+struct PlatformMutex
+{
+    alignas(8) u8 storage[64];
+};
+
+struct PlatformConditionVariable
+{
+    alignas(8) u8 storage[64];
+};
+
+struct PlatformSemaphore
+{
+    alignas(8) u8 storage[32];
+};
+
+// Name is only for debuggers and profilers, it can be null. Linux cuts it to 15 characters.
+PlatformThread platform_thread_create(PlatformThreadProc proc, void* data, const char* name);
+void platform_thread_join(PlatformThread& thread);
+
+// Bit i of the mask lets the thread run on logical processor i. Returns false if the mask wasn't accepted.
+bool platform_thread_set_affinity(PlatformThread& thread, u64 processor_mask);
+
+u64  platform_thread_get_current_id();
+void platform_thread_yield();
+void platform_thread_sleep(f64 seconds);
+
+u32 platform_get_processor_count();     // Logical processors, including hyperthreads
+
+void platform_mutex_create(PlatformMutex& mutex);
+void platform_mutex_destroy(PlatformMutex& mutex);
+void platform_mutex_lock(PlatformMutex& mutex);
+bool platform_mutex_try_lock(PlatformMutex& mutex);
+void platform_mutex_unlock(PlatformMutex& mutex);
+
+void platform_condition_variable_create(PlatformConditionVariable& condition);
+void platform_condition_variable_destroy(PlatformConditionVariable& condition);
+void platform_condition_variable_wait(PlatformConditionVariable& condition, PlatformMutex& mutex);     // Can wake up spuriously
+void platform_condition_variable_wake_one(PlatformConditionVariable& condition);
+void platform_condition_variable_wake_all(PlatformConditionVariable& condition);
+
+void platform_semaphore_create(PlatformSemaphore& semaphore, u32 initial_count);
+void platform_semaphore_destroy(PlatformSemaphore& semaphore);
+void platform_semaphore_wait(PlatformSemaphore& semaphore);
+void platform_semaphore_signal(PlatformSemaphore& semaphore, u32 count = 1);
+
+// Futex style: sleeps while value still holds expected, returns as soon as it might not (or spuriously).
+// Nothing needs to be created for it, so it works on zero initialized statics too.
+void platform_wait_on_address(std::atomic<u32>& value, u32 expected);
+void platform_wake_one(std::atomic<u32>& value);
+void platform_wake_all(std::atomic<u32>& value);
@@ -0,0 +1,491 @@
+#include "platform.h"
+
+#ifdef GN_PLATFORM_LINUX
+
+// Headless backend so the engine's CPU side can be built and run on Linux
+// machines without a display. There's no window, the mouse only remembers
+// where it was put and file dialogues are answered from an environment variable.
+
+#include "core/types.h"
+#include "core/logger.h"
+#include "internal/internal_linux.h"
+#include "internal/tracked_block.h"
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+// Clock Stuff
+static timespec start_time;
+
+static InternalState headless_state;
+
+// Window Stuff
+
+bool platform_window_startup(PlatformState& pstate, const char* window_name, int x, int y, int width, int height, const char* icon_path)
+{
+    headless_state.x = x;
+    headless_state.y = y;
+    headless_state.width  = width;
+    headless_state.height = height;
+
+    pstate.internal_state = &headless_state;
+
+    platform_init_clock();
+
+    return true;
+}
+
+void platform_window_shutdown(PlatformState& pstate)
+{
+    pstate.internal_state = nullptr;
+}
+
+bool platform_pump_messages()
+{
+    return true;
+}
+
+void platform_set_window_style(WindowStyle style)
+{
+}
+
+// Memory Stuff
+
+#ifdef GN_DEBUG
+// Counts calls that go to the heap, to check that frames don't allocate
+static std::atomic<u64> allocation_count = 0;
+#endif // GN_DEBUG
+
+static inline void* linux_allocate_aligned(u64 size, u64 alignment)
+{
+    // posix_memalign wants at least pointer alignment
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*);
+
+    void* block;
+    if (posix_memalign(&block, alignment, size) != 0)
+        return nullptr;
+
+    return block;
+}
+
+// There's no aligned realloc, so try a normal one and only move the block if it lost its alignment
+static inline void* linux_reallocate_aligned(void* block, u64 size, u64 alignment)
+{
+    void* new_block = realloc(block, size);
+    if (!new_block || ((u64) new_block & (alignment - 1)) == 0)
+        return new_block;
+
+    void* aligned_block = linux_allocate_aligned(size, alignment);
+    if (aligned_block)
+        memcpy(aligned_block, new_block, size);
+
+    free(new_block);
+    return aligned_block;
+}
+
+void* platform_allocate(u64 size)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    const u64 offset = sizeof(TrackedBlockHeader);
+    return tracked_block_begin(malloc(size + offset), offset, size, memory_tracker_current_tag());
+#else
+    return malloc(size);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_reallocate(void* block, u64 size)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    if (!block)
+    {
+        const u64 offset = sizeof(TrackedBlockHeader);
+        return tracked_block_begin(malloc(size + offset), offset, size, memory_tracker_current_tag());
+    }
+
+    // Reallocated blocks keep the tag they were allocated with
+    const TrackedBlockHeader header = *tracked_block_header(block);
+
+    void* allocation = realloc(tracked_block_allocation(block), size + header.offset);
+    if (!allocation)
+        return nullptr;
+
+    memory_tracker_record_free(header.tag, header.size);
+    return tracked_block_begin(allocation, header.offset, size, header.tag);
+#else
+    return realloc(block, size);
+#endif // GN_TRACK_MEMORY
+}
+
+u64 platform_get_allocation_count()
+{
+#ifdef GN_DEBUG
+    return allocation_count.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif // GN_DEBUG
+}
+
+void platform_free(void* block)
+{
+#ifdef GN_TRACK_MEMORY
+    if (block)
+        free(tracked_block_end(block));
+#else
+    free(block);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_allocate_aligned(u64 size, u64 alignment)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    const u64 offset = tracked_block_offset(alignment);
+    return tracked_block_begin(linux_allocate_aligned(size + offset, alignment), offset, size, memory_tracker_current_tag());
+#else
+    return linux_allocate_aligned(size, alignment);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_reallocate_aligned(void* block, u64 size, u64 alignment)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    if (!block)
+    {
+        const u64 offset = tracked_block_offset(alignment);
+        return tracked_block_begin(linux_allocate_aligned(size + offset, alignment), offset, size, memory_tracker_current_tag());
+    }
+
+    const TrackedBlockHeader header = *tracked_block_header(block);
+
+    void* allocation = linux_reallocate_aligned(tracked_block_allocation(block), size + header.offset, alignment);
+    if (!allocation)
+        return nullptr;
+
+    memory_tracker_record_free(header.tag, header.size);
+    return tracked_block_begin(allocation, header.offset, size, header.tag);
+#else
+    return linux_reallocate_aligned(block, size, alignment);
+#endif // GN_TRACK_MEMORY
+}
+
+void platform_free_aligned(void* block)
+{
+#ifdef GN_TRACK_MEMORY
+    if (block)
+        free(tracked_block_end(block));
+#else
+    free(block);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_zero_memory(void* dest, u64 size)
+{
+    return memset(dest, 0, size);
+}
+
+void* platform_copy_memory(void* dest, const void* source, u64 size)
+{
+    return memcpy(dest, source, size);
+}
+
+void* platform_move_memory(void* dest, const void* source, u64 size)
+{
+    return memmove(dest, source, size);
+}
+
+void* platform_set_memory(void* dest, s32 value, u64 size)
+{
+    return memset(dest, value, size);
+}
+
+bool platform_compare_memory(const void* ptr1, const void* ptr2, u64 size)
+{
+    return memcmp(ptr1, ptr2, size) == 0;
+}
+
+u64 platform_get_page_size()
+{
+    return (u64) sysconf(_SC_PAGESIZE);
+}
+
+void* platform_reserve_memory(u64 size)
+{
+    // Inaccessible and not counted against the commit limit until it's committed
+    void* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return (address != MAP_FAILED) ? address : nullptr;
+}
+
+bool platform_commit_memory(void* address, u64 size)
+{
+    // Pages only actually get backed the first time they're touched
+    return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void platform_decommit_memory(void* address, u64 size)
+{
+    madvise(address, size, MADV_DONTNEED);
+    mprotect(address, size, PROT_NONE);
+}
+
+void platform_release_memory(void* address, u64 size)
+{
+    munmap(address, size);
+}
+
+// Time Stuff
+
+void platform_init_clock()
+{
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+}
+
+f64 platform_get_time()
+{
+    timespec now_time;
+    clock_gettime(CLOCK_MONOTONIC, &now_time);
+    return (f64) (now_time.tv_sec - start_time.tv_sec) + (f64) (now_time.tv_nsec - start_time.tv_nsec) * 1e-9;
+}
+
+// Input Stuff
+
+static s32 mouse_x, mouse_y;
+
+void platform_get_mouse_position(s32& x, s32& y)
+{
+    x = mouse_x;
+    y = mouse_y;
+}
+
+void platform_set_mouse_position(s32 x, s32 y)
+{
+    mouse_x = x;
+    mouse_y = y;
+}
+
+void platform_show_mouse_cursor(bool value)
+{
+}
+
+// File Stuff
+
+// Scripted through GN_HEADLESS_OPEN_FILE, acts like the dialogue was cancelled if it isn't set
+bool platform_dialogue_open_file(const char filter[], char* out_filepath, u32 max_path_size)
+{
+    const char* filepath = getenv("GN_HEADLESS_OPEN_FILE");
+    if (!filepath || strlen(filepath) + 1 > max_path_size)
+        return false;
+
+    memcpy(out_filepath, filepath, strlen(filepath) + 1);
+    return true;
+}
+
+// Thread Stuff
+
+static_assert(sizeof(pthread_t) <= sizeof(u64), "pthread_t doesn't fit in PlatformThread!");
+static_assert(sizeof(pthread_mutex_t) <= sizeof(PlatformMutex::storage), "pthread_mutex_t doesn't fit in PlatformMutex!");
+static_assert(sizeof(pthread_cond_t) <= sizeof(PlatformConditionVariable::storage), "pthread_cond_t doesn't fit in PlatformConditionVariable!");
+static_assert(sizeof(sem_t) <= sizeof(PlatformSemaphore::storage), "sem_t doesn't fit in PlatformSemaphore!");
+static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Can't wait on the address of std::atomic<u32>!");
+
+struct LinuxThreadStart
+{
+    PlatformThreadProc proc;
+    void* data;
+};
+
+static void* linux_thread_start(void* parameter)
+{
+    // Owned by the new thread since create doesn't wait for it to start
+    const LinuxThreadStart start = *(LinuxThreadStart*) parameter;
+    platform_free(parameter);
+
+    start.proc(start.data);
+    return nullptr;
+}
+
+PlatformThread platform_thread_create(PlatformThreadProc proc, void* data, const char* name)
+{
+    LinuxThreadStart* start = (LinuxThreadStart*) platform_allocate(sizeof(LinuxThreadStart));
+    gn_assert_with_message(start, "Could not allocate thread start data!");
+
+    start->proc = proc;
+    start->data = data;
+
+    pthread_t thread;
+    const int error = pthread_create(&thread, nullptr, linux_thread_start, start);
+    gn_assert_with_message(error == 0, "Could not create thread! (error: %)", error);
+
+    if (name)
+    {
+        // Names can only be 15 characters long
+        char short_name[16];
+        strncpy(short_name, name, sizeof(short_name) - 1);
+        short_name[sizeof(short_name) - 1] = '\0';
+
+        pthread_setname_np(thread, short_name);
+    }
+
+    return PlatformThread { (u64) thread };
+}
+
+void platform_thread_join(PlatformThread& thread)
+{
+    pthread_join((pthread_t) thread.handle, nullptr);
+    thread.handle = 0;
+}
+
+bool platform_thread_set_affinity(PlatformThread& thread, u64 processor_mask)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (u32 i = 0; i < 64; i++)
+    {
+        if (processor_mask & (1ull << i))
+            CPU_SET(i, &set);
+    }
+
+    return pthread_setaffinity_np((pthread_t) thread.handle, sizeof(set), &set) == 0;
+}
+
+u64 platform_thread_get_current_id()
+{
+    return (u64) syscall(SYS_gettid);
+}
+
+void platform_thread_yield()
+{
+    sched_yield();
+}
+
+void platform_thread_sleep(f64 seconds)
+{
+    timespec duration;
+    duration.tv_sec  = (time_t) seconds;
+    duration.tv_nsec = (long) ((seconds - (f64) duration.tv_sec) * 1e9);
+
+    // Sleep again for whatever is left if a signal woke the thread up early
+    while (nanosleep(&duration, &duration) != 0)
+        ;
+}
+
+u32 platform_get_processor_count()
+{
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (u32) count : 1;
+}
+
+void platform_mutex_create(PlatformMutex& mutex)
+{
+    pthread_mutex_init((pthread_mutex_t*) mutex.storage, nullptr);
+}
+
+void platform_mutex_destroy(PlatformMutex& mutex)
+{
+    pthread_mutex_destroy((pthread_mutex_t*) mutex.storage);
+}
+
+void platform_mutex_lock(PlatformMutex& mutex)
+{
+    pthread_mutex_lock((pthread_mutex_t*) mutex.storage);
+}
+
+bool platform_mutex_try_lock(PlatformMutex& mutex)
+{
+    return pthread_mutex_trylock((pthread_mutex_t*) mutex.storage) == 0;
+}
+
+void platform_mutex_unlock(PlatformMutex& mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t*) mutex.storage);
+}
+
+void platform_condition_variable_create(PlatformConditionVariable& condition)
+{
+    pthread_cond_init((pthread_cond_t*) condition.storage, nullptr);
+}
+
+void platform_condition_variable_destroy(PlatformConditionVariable& condition)
+{
+    pthread_cond_destroy((pthread_cond_t*) condition.storage);
+}
+
+void platform_condition_variable_wait(PlatformConditionVariable& condition, PlatformMutex& mutex)
+{
+    pthread_cond_wait((pthread_cond_t*) condition.storage, (pthread_mutex_t*) mutex.storage);
+}
+
+void platform_condition_variable_wake_one(PlatformConditionVariable& condition)
+{
+    pthread_cond_signal((pthread_cond_t*) condition.storage);
+}
+
+void platform_condition_variable_wake_all(PlatformConditionVariable& condition)
+{
+    pthread_cond_broadcast((pthread_cond_t*) condition.storage);
+}
+
+void platform_semaphore_create(PlatformSemaphore& semaphore, u32 initial_count)
+{
+    sem_init((sem_t*) semaphore.storage, 0, initial_count);
+}
+
+void platform_semaphore_destroy(PlatformSemaphore& semaphore)
+{
+    sem_destroy((sem_t*) semaphore.storage);
+}
+
+void platform_semaphore_wait(PlatformSemaphore& semaphore)
+{
+    // Signals can interrupt the wait
+    while (sem_wait((sem_t*) semaphore.storage) != 0)
+        ;
+}
+
+void platform_semaphore_signal(PlatformSemaphore& semaphore, u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+        sem_post((sem_t*) semaphore.storage);
+}
+
+void platform_wait_on_address(std::atomic<u32>& value, u32 expected)
+{
+    syscall(SYS_futex, (u32*) &value, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void platform_wake_one(std::atomic<u32>& value)
+{
+    syscall(SYS_futex, (u32*) &value, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void platform_wake_all(std::atomic<u32>& value)
+{
+    syscall(SYS_futex, (u32*) &value, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#endif // GN_PLATFORM_LINUX
@@ -3,14 +3,18 @@
 #ifdef GN_PLATFORM_WINDOWS
 
 #include "core/types.h"
+#include "core/logger.h"
 #include "core/input.h"
 #include "core/input_processing.h"
 #include "internal/internal_win32.h"
+#include "internal/tracked_block.h"
 #include "graphics/graphics.h"
 #include "application/application.h"
 #include "application/application_internal.h"
+#include <atomic>
 #include <cstdlib>
 #include <windows.h>
+#include <timeapi.h>
 
 // Clock Stuff
 static f64 clock_frequency;
@@ -121,6 +125,8 @@ void platform_window_shutdown(PlatformState& pstate)
         DestroyWindow(state.hwnd);
         state.hwnd = 0;
     }
+
+    timeEndPeriod(1);
 }
 
 bool platform_pump_messages()
@@ -164,19 +170,120 @@ void platform_set_window_style(WindowStyle style)
 }
 
 // Memory Stuff
+
+#ifdef GN_DEBUG
+// Counts calls that go to the heap, to check that frames don't allocate
+static std::atomic<u64> allocation_count = 0;
+#endif // GN_DEBUG
+
 void* platform_allocate(u64 size)
 {
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    const u64 offset = sizeof(TrackedBlockHeader);
+    return tracked_block_begin(malloc(size + offset), offset, size, memory_tracker_current_tag());
+#else
     return malloc(size);
+#endif // GN_TRACK_MEMORY
 }
 
 void* platform_reallocate(void* block, u64 size)
 {
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    if (!block)
+    {
+        const u64 offset = sizeof(TrackedBlockHeader);
+        return tracked_block_begin(malloc(size + offset), offset, size, memory_tracker_current_tag());
+    }
+
+    // Reallocated blocks keep the tag they were allocated with
+    const TrackedBlockHeader header = *tracked_block_header(block);
+
+    void* allocation = realloc(tracked_block_allocation(block), size + header.offset);
+    if (!allocation)
+        return nullptr;
+
+    memory_tracker_record_free(header.tag, header.size);
+    return tracked_block_begin(allocation, header.offset, size, header.tag);
+#else
     return realloc(block, size);
+#endif // GN_TRACK_MEMORY
+}
+
+u64 platform_get_allocation_count()
+{
+#ifdef GN_DEBUG
+    return allocation_count.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif // GN_DEBUG
 }
 
 void platform_free(void* block)
 {
+#ifdef GN_TRACK_MEMORY
+    if (block)
+        free(tracked_block_end(block));
+#else
     free(block);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_allocate_aligned(u64 size, u64 alignment)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    const u64 offset = tracked_block_offset(alignment);
+    return tracked_block_begin(_aligned_malloc(size + offset, alignment), offset, size, memory_tracker_current_tag());
+#else
+    return _aligned_malloc(size, alignment);
+#endif // GN_TRACK_MEMORY
+}
+
+void* platform_reallocate_aligned(void* block, u64 size, u64 alignment)
+{
+#ifdef GN_DEBUG
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#endif // GN_DEBUG
+
+#ifdef GN_TRACK_MEMORY
+    if (!block)
+    {
+        const u64 offset = tracked_block_offset(alignment);
+        return tracked_block_begin(_aligned_malloc(size + offset, alignment), offset, size, memory_tracker_current_tag());
+    }
+
+    const TrackedBlockHeader header = *tracked_block_header(block);
+
+    void* allocation = _aligned_realloc(tracked_block_allocation(block), size + header.offset, alignment);
+    if (!allocation)
+        return nullptr;
+
+    memory_tracker_record_free(header.tag, header.size);
+    return tracked_block_begin(allocation, header.offset, size, header.tag);
+#else
+    return _aligned_realloc(block, size, alignment);
+#endif // GN_TRACK_MEMORY
+}
+
+void platform_free_aligned(void* block)
+{
+#ifdef GN_TRACK_MEMORY
+    if (block)
+        _aligned_free(tracked_block_end(block));
+#else
+    _aligned_free(block);
+#endif // GN_TRACK_MEMORY
 }
 
 void* platform_zero_memory(void* dest, u64 size)
@@ -189,6 +296,11 @@ void* platform_copy_memory(void* dest, const void* source, u64 size)
     return memcpy(dest, source, size);
 }
 
+void* platform_move_memory(void* dest, const void* source, u64 size)
+{
+    return memmove(dest, source, size);
+}
+
 void* platform_set_memory(void* dest, s32 value, u64 size)
 {
     return memset(dest, value, size);
@@ -199,6 +311,34 @@ bool platform_compare_memory(const void* ptr1, const void* ptr2, u64 size)
     return memcmp(ptr1, ptr2, size) == 0;
 }
 
+u64 platform_get_page_size()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+void* platform_reserve_memory(u64 size)
+{
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool platform_commit_memory(void* address, u64 size)
+{
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+void platform_decommit_memory(void* address, u64 size)
+{
+    VirtualFree(address, size, MEM_DECOMMIT);
+}
+
+void platform_release_memory(void* address, u64 size)
+{
+    // Releasing has to be done for the whole reservation at once
+    VirtualFree(address, 0, MEM_RELEASE);
+}
+
 // Time Stuff
 
 void platform_init_clock()
@@ -207,6 +347,9 @@ void platform_init_clock()
     QueryPerformanceFrequency(&frequency);
     clock_frequency = 1.0 / (f64) frequency.QuadPart;
     QueryPerformanceCounter(&start_time);
+
+    // Sleep() rounds up to the scheduler tick, which is 15.6 ms by default. That's a whole frame, so ask for 1 ms.
+    timeBeginPeriod(1);
 }
 
 f64 platform_get_time()
@@ -376,4 +519,168 @@ bool platform_dialogue_open_file(const char filter[], char* out_filepath, u32 ma
     return false;
 }
 
+// Thread Stuff
+
+static_assert(sizeof(SRWLOCK) <= sizeof(PlatformMutex::storage), "SRWLOCK doesn't fit in PlatformMutex!");
+static_assert(sizeof(CONDITION_VARIABLE) <= sizeof(PlatformConditionVariable::storage), "CONDITION_VARIABLE doesn't fit in PlatformConditionVariable!");
+static_assert(sizeof(HANDLE) <= sizeof(PlatformSemaphore::storage), "HANDLE doesn't fit in PlatformSemaphore!");
+static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Can't wait on the address of std::atomic<u32>!");
+
+struct Win32ThreadStart
+{
+    PlatformThreadProc proc;
+    void* data;
+};
+
+static DWORD WINAPI win32_thread_start(LPVOID parameter)
+{
+    // Owned by the new thread since create doesn't wait for it to start
+    const Win32ThreadStart start = *(Win32ThreadStart*) parameter;
+    platform_free(parameter);
+
+    start.proc(start.data);
+    return 0;
+}
+
+PlatformThread platform_thread_create(PlatformThreadProc proc, void* data, const char* name)
+{
+    Win32ThreadStart* start = (Win32ThreadStart*) platform_allocate(sizeof(Win32ThreadStart));
+    gn_assert_with_message(start, "Could not allocate thread start data!");
+
+    start->proc = proc;
+    start->data = data;
+
+    HANDLE handle = CreateThread(NULL, 0, win32_thread_start, start, 0, NULL);
+    gn_assert_with_message(handle, "Could not create thread! (error: %)", (u32) GetLastError());
+
+    if (name)
+    {
+        wchar_t wide_name[64];
+        if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wide_name, 64) > 0)
+            SetThreadDescription(handle, wide_name);
+    }
+
+    return PlatformThread { (u64) handle };
+}
+
+void platform_thread_join(PlatformThread& thread)
+{
+    WaitForSingleObject((HANDLE) thread.handle, INFINITE);
+    CloseHandle((HANDLE) thread.handle);
+
+    thread.handle = 0;
+}
+
+bool platform_thread_set_affinity(PlatformThread& thread, u64 processor_mask)
+{
+    return SetThreadAffinityMask((HANDLE) thread.handle, (DWORD_PTR) processor_mask) != 0;
+}
+
+u64 platform_thread_get_current_id()
+{
+    return GetCurrentThreadId();
+}
+
+void platform_thread_yield()
+{
+    SwitchToThread();
+}
+
+void platform_thread_sleep(f64 seconds)
+{
+    Sleep((DWORD) (seconds * 1000.0));
+}
+
+u32 platform_get_processor_count()
+{
+    return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+}
+
+void platform_mutex_create(PlatformMutex& mutex)
+{
+    InitializeSRWLock((SRWLOCK*) mutex.storage);
+}
+
+void platform_mutex_destroy(PlatformMutex& mutex)
+{
+    // SRW locks don't own anything
+}
+
+void platform_mutex_lock(PlatformMutex& mutex)
+{
+    AcquireSRWLockExclusive((SRWLOCK*) mutex.storage);
+}
+
+bool platform_mutex_try_lock(PlatformMutex& mutex)
+{
+    return TryAcquireSRWLockExclusive((SRWLOCK*) mutex.storage) != 0;
+}
+
+void platform_mutex_unlock(PlatformMutex& mutex)
+{
+    ReleaseSRWLockExclusive((SRWLOCK*) mutex.storage);
+}
+
+void platform_condition_variable_create(PlatformConditionVariable& condition)
+{
+    InitializeConditionVariable((CONDITION_VARIABLE*) condition.storage);
+}
+
+void platform_condition_variable_destroy(PlatformConditionVariable& condition)
+{
+}
+
+void platform_condition_variable_wait(PlatformConditionVariable& condition, PlatformMutex& mutex)
+{
+    SleepConditionVariableSRW((CONDITION_VARIABLE*) condition.storage, (SRWLOCK*) mutex.storage, INFINITE, 0);
+}
+
+void platform_condition_variable_wake_one(PlatformConditionVariable& condition)
+{
+    WakeConditionVariable((CONDITION_VARIABLE*) condition.storage);
+}
+
+void platform_condition_variable_wake_all(PlatformConditionVariable& condition)
+{
+    WakeAllConditionVariable((CONDITION_VARIABLE*) condition.storage);
+}
+
+void platform_semaphore_create(PlatformSemaphore& semaphore, u32 initial_count)
+{
+    HANDLE handle = CreateSemaphoreA(NULL, (LONG) initial_count, LONG_MAX, NULL);
+    gn_assert_with_message(handle, "Could not create semaphore! (error: %)", (u32) GetLastError());
+
+    *(HANDLE*) semaphore.storage = handle;
+}
+
+void platform_semaphore_destroy(PlatformSemaphore& semaphore)
+{
+    CloseHandle(*(HANDLE*) semaphore.storage);
+}
+
+void platform_semaphore_wait(PlatformSemaphore& semaphore)
+{
+    WaitForSingleObject(*(HANDLE*) semaphore.storage, INFINITE);
+}
+
+void platform_semaphore_signal(PlatformSemaphore& semaphore, u32 count)
+{
+    ReleaseSemaphore(*(HANDLE*) semaphore.storage, (LONG) count, NULL);
+}
+
+void platform_wait_on_address(std::atomic<u32>& value, u32 expected)
+{
+    WaitOnAddress(&value, &expected, sizeof(u32), INFINITE);
+}
+
+void platform_wake_one(std::atomic<u32>& value)
+{
+    WakeByAddressSingle(&value);
+}
+
+void platform_wake_all(std::atomic<u32>& value)
+{
+    WakeByAddressAll(&value);
+}
+
 #endif // GN_PLATFORM_WINDOWS
\ No newline at end of file
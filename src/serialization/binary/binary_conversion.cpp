@@ -119,16 +119,11 @@ static void encode_json_value_to_binary(DynamicArray<u8>& bytes, Json::Value val
             const Json::Document* document = object.document;
             const Json::ObjectNode object_node = document->dependency_tree[object.tree_index].object;
 
-            u32 encoded_count = 0;
-            for (u32 i = 0; encoded_count < object_node.filled && i < object_node.capacity; i++)
+            for (auto elem : object_node)
             {
-                if (object_node.states[i] == Json::ObjectNode::State::ALIVE)
-                {
-                    // append_string(bytes, object_node.keys[i]);
-                    Json::Value property = { document, object_node.values[i] };
-                    encode_json_value_to_binary(bytes, property);
-                    encoded_count++;
-                }
+                // append_string(bytes, elem.key());
+                Json::Value property = { document, elem.value() };
+                encode_json_value_to_binary(bytes, property);
             }
 
             append(bytes, OBJECT_END);
@@ -138,7 +133,7 @@ static void encode_json_value_to_binary(DynamicArray<u8>& bytes, Json::Value val
 
 Bytes json_document_to_binary(const Json::Document& document)
 {
-    DynamicArray<u8> output = make<DynamicArray<u8>>(1024ui64);
+    DynamicArray<u8> output = make<DynamicArray<u8>>(1024ull);
 
     encode_json_value_to_binary(output, document.start());
 
@@ -366,7 +366,7 @@ inline String get(const Bytes& bytes, u64& offset)
             u8 size = *(bytes.data + offset + 1);
             gn_assert_with_message(offset + 1 + size < bytes.size, "String data exceeds the size of byte array! (offset: %, array size: %)", offset, bytes.size);
 
-            String str;
+            String str = {};
             str.data = (char*) (bytes.data + offset + 2);
             str.size = (u64) size;
 
@@ -381,7 +381,7 @@ inline String get(const Bytes& bytes, u64& offset)
             u16 size = *(u16*)(bytes.data + offset + 1);
             gn_assert_with_message(offset + 2 + size < bytes.size, "String data exceeds the size of byte array! (offset: %, array size: %)", offset, bytes.size);
 
-            String str;
+            String str = {};
             str.data = (char*) (bytes.data + offset + 3);
             str.size = (u64) size;
             
@@ -396,7 +396,7 @@ inline String get(const Bytes& bytes, u64& offset)
             u32 size = *(u32*)(bytes.data + offset + 1);
             gn_assert_with_message(offset + 4 + size < bytes.size, "String data exceeds the size of byte array! (offset: %, array size: %)", offset, bytes.size);
 
-            String str;
+            String str = {};
             str.data = (char*) (bytes.data + offset + 5);
             str.size = (u64) size;
             
@@ -411,7 +411,7 @@ inline String get(const Bytes& bytes, u64& offset)
             u64 size = *(u64*)(bytes.data + offset + 1);
             gn_assert_with_message(offset + 8 + size < bytes.size, "String data exceeds the size of byte array! (offset: %, array size: %)", offset, bytes.size);
 
-            String str;
+            String str = {};
             str.data = (char*) (bytes.data + offset + 9);
             str.size = (u64) size;
 
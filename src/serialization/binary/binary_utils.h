@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "containers/bytes.h"
 #include "containers/darray.h"
 #include "containers/string.h"
 #include "binary_types.h"
@@ -8,13 +9,17 @@
 namespace Binary
 {
 
-static inline void append_integer(DynamicArray<u8>& bytes, const s8 val)
+// Appends work on any u8 array with append and append_many, like DynamicArray or VirtualArray
+
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const s8 val)
 {
     const u8* as_bytes = (u8*) &val;
     append(bytes, as_bytes[0]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const s16 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const s16 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -22,7 +27,8 @@ static inline void append_integer(DynamicArray<u8>& bytes, const s16 val)
     append(bytes, as_bytes[1]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const s32 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const s32 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -32,7 +38,8 @@ static inline void append_integer(DynamicArray<u8>& bytes, const s32 val)
     append(bytes, as_bytes[3]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const s64 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const s64 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -46,13 +53,15 @@ static inline void append_integer(DynamicArray<u8>& bytes, const s64 val)
     append(bytes, as_bytes[7]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const u8 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const u8 val)
 {
     const u8* as_bytes = (u8*) &val;
     append(bytes, as_bytes[0]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const u16 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const u16 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -60,7 +69,8 @@ static inline void append_integer(DynamicArray<u8>& bytes, const u16 val)
     append(bytes, as_bytes[1]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const u32 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const u32 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -70,7 +80,8 @@ static inline void append_integer(DynamicArray<u8>& bytes, const u32 val)
     append(bytes, as_bytes[3]);
 }
 
-static inline void append_integer(DynamicArray<u8>& bytes, const u64 val)
+template <typename ByteArray>
+static inline void append_integer(ByteArray& bytes, const u64 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -84,7 +95,8 @@ static inline void append_integer(DynamicArray<u8>& bytes, const u64 val)
     append(bytes, as_bytes[7]);
 }
 
-static inline void append_float(DynamicArray<u8>& bytes, const f32 val)
+template <typename ByteArray>
+static inline void append_float(ByteArray& bytes, const f32 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -94,7 +106,8 @@ static inline void append_float(DynamicArray<u8>& bytes, const f32 val)
     append(bytes, as_bytes[3]);
 }
 
-static inline void append_float(DynamicArray<u8>& bytes, const f64 val)
+template <typename ByteArray>
+static inline void append_float(ByteArray& bytes, const f64 val)
 {
     // TODO: Think about endianness (right now it's only little endian)
     const u8* as_bytes = (u8*) &val;
@@ -108,7 +121,8 @@ static inline void append_float(DynamicArray<u8>& bytes, const f64 val)
     append(bytes, as_bytes[7]);
 }
 
-static inline void append_string(DynamicArray<u8>& bytes, const String str)
+template <typename ByteArray>
+static inline void append_string(ByteArray& bytes, const String str)
 {
     // encode string length
     if (str.size <= 0xffu)
@@ -136,20 +150,21 @@ static inline void append_string(DynamicArray<u8>& bytes, const String str)
     append_many(bytes, (u8*) str.data, str.size);
 }
 
-static inline void append_bytes(DynamicArray<u8>& bytes, const u8* raw_bytes, const u64 size)
+template <typename ByteArray>
+static inline void append_bytes(ByteArray& bytes, const u8* raw_bytes, const u64 size)
 {
     // encode array length
-    if (size <= 0xffUi64)
+    if (size <= 0xffull)
     {
         append(bytes, Binary::BYTE_ARRAY_1_BYTE);
         Binary::append_integer(bytes, (u8) size);
     }
-    else if (size <= 0xffffUi64)
+    else if (size <= 0xffffull)
     {
         append(bytes, Binary::BYTE_ARRAY_2_BYTE);
         Binary::append_integer(bytes, (u16) size);
     }
-    else if (size <= 0xffffffffUi64)
+    else if (size <= 0xffffffffull)
     {
         append(bytes, Binary::BYTE_ARRAY_4_BYTE);
         Binary::append_integer(bytes, (u32) size);
@@ -164,7 +179,8 @@ static inline void append_bytes(DynamicArray<u8>& bytes, const u8* raw_bytes, co
     append_many(bytes, raw_bytes, size);
 }
 
-static inline void append_image(DynamicArray<u8>& bytes, const String name, const u8* pixels, const s32 width, const s32 height, const s32 bytes_pp)
+template <typename ByteArray>
+static inline void append_image(ByteArray& bytes, const String name, const u8* pixels, const s32 width, const s32 height, const s32 bytes_pp)
 {
     {   // Encode meta data
         append(bytes, Binary::INTEGER_S32);
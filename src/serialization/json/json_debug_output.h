@@ -67,13 +67,10 @@ static u64 print_node_info(const Document& document, u64 index)
         {
             print("::Object Start::\n");
 
-            for (u64 i = 0; i < node.object.capacity; i++)
+            for (auto elem : node.object)
             {
-                if (node.object.states[i] == ObjectNode::State::ALIVE)
-                {
-                    print("%: ", node.object.keys[i]);
-                    index = print_node_info(document, node.object.values[i]);
-                }
+                print("%: ", elem.key());
+                index = print_node_info(document, elem.value());
             }
 
             print("::Object End::\n");
@@ -5,6 +5,7 @@
 #include "containers/darray.h"
 #include "containers/string.h"
 #include "containers/hash_table.h"
+#include "core/atom.h"
 
 namespace Json
 {
@@ -21,7 +22,7 @@ Value Array::operator[](u64 index) const
 }
 
 // Returns null if key isn't found
-Value Object::operator[](const String& key) const
+Value Object::operator[](const Atom key) const
 {
     DependencyNode node = document->dependency_tree[tree_index];
     auto elem = find(node.object, key);
@@ -33,4 +34,17 @@ Value Object::operator[](const String& key) const
     return Value { document, elem.value() };
 }
 
+// Returns null if key isn't found
+Value Object::operator[](const String& key) const
+{
+    // Key can't be in any object if it was never interned
+    return (*this)[atom_find(key)];
+}
+
+// Returns null if key isn't found
+Value Object::operator[](const HashedString& key) const
+{
+    return (*this)[atom_find(key)];
+}
+
 } // namespace Json
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "containers/darray.h"
 #include "containers/string.h"
 #include "containers/hash_table.h"
+#include "core/atom.h"
 #include "json_types.h"
 
 namespace Json
@@ -12,7 +13,7 @@ namespace Json
 
 using ResourceIndex = u64;
 using ArrayNode = DynamicArray<ResourceIndex>;
-using ObjectNode = HashTable<String, ResourceIndex>;
+using ObjectNode = HashTable<Atom, ResourceIndex>;   // Keys are interned
 
 union Resource
 {
@@ -43,6 +44,9 @@ struct Document
     DynamicArray<DependencyNode> dependency_tree;
     DynamicArray<Resource>       resources;
 
+    // Everything the parser creates for the document comes from here
+    Allocator* allocator;
+
     Value start() const;
 };
 
@@ -67,6 +71,8 @@ struct Object
 
     // Returns null if key isn't found
     Value operator[](const String& key) const;
+    Value operator[](const HashedString& key) const;
+    Value operator[](const Atom key) const;
 };
 
 struct Value
@@ -157,7 +163,7 @@ struct Value
     }
     
     // Returns null if key isn't found
-    Value operator[](const String& key) const
+    Value operator[](const Atom key) const
     {
         DependencyNode node = document->dependency_tree[tree_index];
         gn_assert_with_message(node.type == Type::OBJECT,
@@ -172,18 +178,32 @@ struct Value
 
         return Value { document, elem.value() };
     }
+
+    // Returns null if key isn't found
+    Value operator[](const String& key) const
+    {
+        // Key can't be in any object if it was never interned
+        return (*this)[atom_find(key)];
+    }
+
+    // Returns null if key isn't found
+    Value operator[](const HashedString& key) const
+    {
+        return (*this)[atom_find(key)];
+    }
 };
 
 } // namespace Json
 
-inline Json::Document make(Type<Json::Document>, u64 start_cap = 16)
+inline Json::Document make(Type<Json::Document>, u64 start_cap = 16, Allocator* allocator = nullptr)
 {
     using namespace Json;
 
     Document document;
 
-    document.resources = make<DynamicArray<Resource>>(start_cap);
-    document.dependency_tree = make<DynamicArray<DependencyNode>>(start_cap);
+    document.allocator = allocator;
+    document.resources = make<DynamicArray<Resource>>(start_cap, allocator);
+    document.dependency_tree = make<DynamicArray<DependencyNode>>(start_cap, allocator);
 
     return document;
 }
@@ -208,8 +228,7 @@ inline void free(Json::Document& document)
             case Json::Type::OBJECT:
             {
                 Json::ObjectNode node = document.dependency_tree[i].object;
-                free_keys(node);    // Keys are all strings
-                free(node);
+                free(node);         // Keys are atoms so they aren't owned by the document
             } break;
         }
     }
@@ -24,7 +24,7 @@ inline static bool is_digit(char ch)
 bool lex(const String content, DynamicArray<Token>& tokens)
 {
     clear(tokens);
-    resize(tokens, max(2ui64, content.size / 10)); // Just an estimate
+    resize(tokens, max(2ull, content.size / 10)); // Just an estimate
 
     bool encountered_error = false;
     u64 current_index = 0;
@@ -60,7 +60,7 @@ bool lex(const String content, DynamicArray<Token>& tokens)
                 Token token;
                 token.index = current_index;
                 token.type  = (Token::Type) content[current_index];
-                token.value = ref(content.data + current_index, 1);
+                token.value = view(content.data + current_index, 1);
 
                 append(tokens, token);
 
@@ -108,7 +108,7 @@ bool lex(const String content, DynamicArray<Token>& tokens)
                 Token token;
                 token.index = current_index;
                 token.type  = Token::Type::STRING;
-                token.value = ref(content.data + current_index, str_size);
+                token.value = view(content.data + current_index, str_size);
 
                 append(tokens, token);
 
@@ -159,7 +159,7 @@ bool lex(const String content, DynamicArray<Token>& tokens)
                 Token token;
                 token.index = current_index;
                 token.type  = encountered_dot ? Token::Type::FLOAT : Token::Type::INTEGER;
-                token.value = ref(content.data + current_index, number_size);
+                token.value = view(content.data + current_index, number_size);
 
                 append(tokens, token);
 
@@ -194,7 +194,7 @@ bool lex(const String content, DynamicArray<Token>& tokens)
                 Token token;
                 token.index = current_index;
                 token.type  = Token::Type::IDENTIFIER;
-                token.value = ref(content.data + current_index, identifier_size);
+                token.value = view(content.data + current_index, identifier_size);
 
                 append(tokens, token);
 
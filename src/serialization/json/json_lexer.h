@@ -3,6 +3,7 @@
 #include "core/types.h"
 #include "containers/darray.h"
 #include "containers/string.h"
+#include "containers/string_view.h"
 
 namespace Json
 {
@@ -30,7 +31,7 @@ struct Token
 
     Type type;
     u64 index;
-    String value;   // Not owned
+    StringView value;   // Points into the content being lexed
 };
 
 bool lex(const String content, DynamicArray<Token>& tokens);
@@ -1,7 +1,11 @@
 #include "json_parser.h"
 
+#include <cstdlib>
 #include "core/types.h"
 #include "core/logger.h"
+#include "core/atom.h"
+#include "core/memory_tracker.h"
+#include "containers/small_array.h"
 #include "json_debug_output.h"
 #include "json_document.h"
 #include "json_lexer.h"
@@ -42,10 +46,12 @@ static inline bool is_token_a_value(Token::Type type)
     return false;
 }
 
-static String copy_and_escape(const String source, ParserContext& context)
-{
-    DynamicArray<char> result = make<DynamicArray<char>>(source.size);
+// Strings are escaped into a small inline buffer first so
+// short ones (like most keys) don't need a heap allocation
+using EscapeBuffer = SmallArray<char, 64>;
 
+static void escape(EscapeBuffer& result, const StringView source, ParserContext& context)
+{
     for (u64 i = 0; i < source.size; i++)
     {
         char ch = source[i];
@@ -76,8 +82,28 @@ static String copy_and_escape(const String source, ParserContext& context)
 
         append(result, ch);
     }
+}
 
-    return String { result.data, result.size };
+static String copy_and_escape(const StringView source, ParserContext& context, Allocator* allocator)
+{
+    EscapeBuffer result = make<EscapeBuffer>();
+    escape(result, source, context);
+
+    String str = make<String>(StringView { result.data(), result.size }, allocator);
+    free(result);
+
+    return str;
+}
+
+static Atom intern_and_escape(const StringView source, ParserContext& context)
+{
+    EscapeBuffer result = make<EscapeBuffer>();
+    escape(result, source, context);
+
+    Atom atom = atom_intern(String { result.data(), result.size, nullptr });
+    free(result);
+
+    return atom;
 }
 
 static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context, Document& out)
@@ -97,7 +123,7 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
             ResourceIndex index = out.resources.size;
 
             Resource res = {};
-            res.string = copy_and_escape(token.value, context);
+            res.string = copy_and_escape(token.value, context, out.allocator);
             append(out.resources, res);
 
             DependencyNode node = {};
@@ -113,7 +139,7 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
 
             // TODO: convert string to integer on your own with error checking
             Resource res = {};
-            res.integer64 = _atoi64(token.value.data);
+            res.integer64 = strtoll(token.value.data, nullptr, 10);
             append(out.resources, res);
 
             DependencyNode node = {};
@@ -143,18 +169,18 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
             Type node_type = Type::BOOLEAN;
 
             {   // Determine type of resource
-                if (token.value == ref("null", 4))
+                if (token.value == view("null"))
                 {
                     // Point to null value in dependency tree
                     node_type = Type::NONE;
                     index = 0;
                 }
-                else if (token.value == ref("true", 4))
+                else if (token.value == view("true"))
                 {
                     // Point to true value in dependency tree
                     index = 2;
                 }
-                else if (token.value == ref("false", 5))
+                else if (token.value == view("false"))
                 {
                     // Point to true value in dependency tree
                     index = 1;
@@ -178,7 +204,7 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
             u64 array_tree_index = out.dependency_tree.size;
 
             DependencyNode node = {};
-            node.array = make<ArrayNode>();
+            node.array = make<ArrayNode>(16ull, out.allocator);
             node.type  = Type::ARRAY;
             append(out.dependency_tree, node);
 
@@ -235,7 +261,7 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
             u64 object_tree_index = out.dependency_tree.size;
 
             DependencyNode node = {};
-            node.object = make<ObjectNode>();
+            node.object = make<ObjectNode>((u32) 32, out.allocator);
             node.type  = Type::OBJECT;
             append(out.dependency_tree, node);
 
@@ -277,8 +303,8 @@ static void parse_next(const DynamicArray<Token>& tokens, ParserContext& context
                         context.current_index--;
                 }
 
-                String key_string = copy_and_escape(key_token.value, context);
-                put(out.dependency_tree[object_tree_index].object, key_string, out.dependency_tree.size);
+                Atom key = intern_and_escape(key_token.value, context);
+                put(out.dependency_tree[object_tree_index].object, key, out.dependency_tree.size);
 
                 context.current_index++;
                 parse_next(tokens, context, out);
@@ -384,6 +410,8 @@ bool parse_tokens(const DynamicArray<Token>& tokens, const String content, Docum
 
 bool parse_string(const String content, Document& out)
 {
+    memory_tracker_push_tag(MemoryTag::JSON);
+
     DynamicArray<Json::Token> tokens = {};
     bool success = lex(content, tokens);
 
@@ -401,6 +429,8 @@ bool parse_string(const String content, Document& out)
 err_lexing:
     free(tokens);
 
+    memory_tracker_pop_tag();
+
     return success;
 }
 
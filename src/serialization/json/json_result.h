@@ -20,7 +20,7 @@ inline u64 line_number(const String str, u64 index)
 
 #ifdef GN_DEBUG
 #include "core/logger.h"
-#define log_error(fmt, ...) print_error("Json Error: "fmt"\n", __VA_ARGS__)
+#define log_error(fmt, ...) print_error("Json Error: " fmt "\n", ##__VA_ARGS__)
 #else
 #define log_error(fmt, ...)
 #endif // GN_DEBUG
\ No newline at end of file
@@ -0,0 +1,218 @@
+// Quick check that the headless library works, built by build.sh.
+// Exits with 1 if anything failed so CI can run it as is.
+
+#include "core/types.h"
+#include "core/atom.h"
+#include "core/coroutines.h"
+#include "core/linear_arena.h"
+#include "containers/darray.h"
+#include "containers/hash_table.h"
+#include "containers/queue.h"
+#include "containers/sort.h"
+#include "containers/string_builder.h"
+#include "containers/string_view.h"
+#include "containers/text_buffer.h"
+#include "containers/virtual_array.h"
+#include "fileio/compression.h"
+#include "serialization/json.h"
+#include "platform/platform.h"
+
+#include <cstdio>
+
+static u32 failed_checks = 0;
+
+#define check(x) if (!(x)) { printf("FAILED: %s (%s:%d)\n", #x, __FILE__, __LINE__); failed_checks++; }
+
+static void test_containers()
+{
+    DynamicArray<s32> arr = make<DynamicArray<s32>>();
+    for (s32 i = 0; i < 1000; i++)
+        append(arr, 999 - i);
+
+    sort(arr);
+    check(arr.size == 1000 && arr[0] == 0 && arr[999] == 999);
+    free(arr);
+
+    HashTable<s32, s32> table = make<HashTable<s32, s32>>();
+    for (s32 i = 0; i < 1000; i++)
+        put(table, i, i * 2);
+
+    for (s32 i = 0; i < 1000; i += 2)
+    {
+        auto element = find(table, i);
+        remove(element);
+    }
+
+    check(table.count == 500);
+    check(find(table, 7) && find(table, 7).value() == 14);
+    check(!find(table, 8));
+    free(table);
+
+    VirtualArray<u64> big = make<VirtualArray<u64>>(1ull << 30);
+    for (u64 i = 0; i < 100000; i++)
+        append(big, i);
+
+    check(big.size == 100000 && big[99999] == 99999);
+    free(big);
+}
+
+static void test_strings()
+{
+    StringBuilder builder = make<StringBuilder>();
+    append_format(builder, "% + % = %", 1, 2, 3);
+    check(view(ref(builder)) == view("1 + 2 = 3"));
+    free(builder);
+
+    const Atom a = atom_intern(hashed_ref("smoke"));
+    check(a == atom_intern(hashed_ref("smoke")) && view(atom_string(a)) == view("smoke"));
+
+    TextBuffer text = make<TextBuffer>(view("first\nsecond\nthird", 18));
+    check(line_count(text) == 3);
+    remove(text, 5, 1);
+    insert(text, 0, view("zero\n", 5));
+    check(line_count(text) == 3 && line_start(text, 2) == 17);
+    free(text);
+}
+
+static void test_serialization()
+{
+    // ref() takes a char* so the text can't be a literal
+    char text[] = "{ \"name\": \"smoke\", \"values\": [1, 2.5, true] }";
+
+    Json::Document document = {};
+    const bool parsed = Json::parse_string(ref(text), document);
+    check(parsed);
+
+    if (parsed)
+    {
+        const Json::Object root = document.start().object();
+        check(view(root[hashed_ref("name")].string()) == view("smoke"));
+        check(root[hashed_ref("values")].array().size() == 3);
+        check(root[hashed_ref("values")].array()[0].int64() == 1);
+        free(document);
+    }
+
+    Bytes bytes = { (u8*) platform_allocate(4096), 4096 };
+    for (u64 i = 0; i < bytes.size; i++)
+        bytes[i] = (u8) (i % 7);
+
+    Bytes compressed = compress_bytes(bytes);
+    Bytes decompressed = decompress_bytes(compressed);
+    check(compressed.size < bytes.size);
+    check(decompressed.size == bytes.size && platform_compare_memory(decompressed.data, bytes.data, bytes.size));
+
+    free(bytes);
+    free(compressed);
+    free(decompressed);
+}
+
+static void count_to_three(Coroutine& co, u32& value)
+{
+    coroutine_start(co);
+
+    value = 1;
+    coroutine_yield(co);
+    value = 2;
+    coroutine_yield(co);
+    value = 3;
+
+    coroutine_end(co);
+}
+
+static void run_nested(Coroutine& co, u32& value)
+{
+    coroutine_start(co);
+
+    coroutine_call(co, count_to_three(co, value));
+    value = 10;
+
+    coroutine_end(co);
+}
+
+static void test_coroutines()
+{
+    Coroutine co = {};
+    u32 value = 0;
+
+    run_nested(co, value);
+    check(value == 1 && co.running);
+    run_nested(co, value);
+    check(value == 2 && co.running);
+    run_nested(co, value);
+    check(value == 10 && !co.running);
+}
+
+static void test_threads()
+{
+    static MpmcQueue<u64> queue = make<MpmcQueue<u64>>(1024ull);
+    static std::atomic<u64> sum;
+
+    auto producer = [](void*)
+    {
+        for (u64 i = 1; i <= 10000; i++)
+            while (!push(queue, i))
+                platform_thread_yield();
+    };
+
+    auto consumer = [](void*)
+    {
+        u64 item;
+        for (u64 received = 0; received < 10000; )
+        {
+            if (pop(queue, item))
+            {
+                sum += item;
+                received++;
+            }
+        }
+    };
+
+    PlatformThread threads[4] = {
+        platform_thread_create(producer, nullptr, "producer 0"),
+        platform_thread_create(producer, nullptr, "producer 1"),
+        platform_thread_create(consumer, nullptr, "consumer 0"),
+        platform_thread_create(consumer, nullptr, "consumer 1"),
+    };
+
+    for (PlatformThread& thread : threads)
+        platform_thread_join(thread);
+
+    check(sum == 2 * (10000ull * 10001ull / 2));
+    free(queue);
+
+    DynamicArray<u64> keys = make<DynamicArray<u64>>();
+    for (u64 i = 0; i < 1000000; i++)
+        append(keys, (i * 0x9E3779B97F4A7C15ull) >> 7);
+
+    radix_sort(keys, [](u64 key) { return key; });
+
+    bool sorted = true;
+    for (u64 i = 1; i < keys.size; i++)
+        sorted &= keys[i - 1] <= keys[i];
+
+    check(sorted);
+    free(keys);
+}
+
+int main()
+{
+    platform_init_clock();
+
+    test_containers();
+    test_strings();
+    test_serialization();
+    test_coroutines();
+    test_threads();
+
+    LinearArena& arena = frame_arena();
+    check(push(arena, arena.capacity + 1) == nullptr);
+
+    if (failed_checks > 0)
+    {
+        printf("%u checks failed\n", failed_checks);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+    return 0;
+}